@@ -0,0 +1,207 @@
+import 'dart:async';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:math';
+import 'package:flutter/widgets.dart';
+import 'package:media_kit/media_kit.dart';
+import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
+
+import 'package:harmonoid/core/configuration/configuration.dart';
+import 'package:harmonoid/core/filesystem_media_library.dart';
+import 'package:harmonoid/core/media_library_search_index.dart';
+import 'package:harmonoid/core/media_player/media_player.dart';
+import 'package:harmonoid/core/track_sort_index.dart';
+import 'package:harmonoid/extensions/string.dart';
+import 'package:harmonoid/mappers/track.dart';
+
+/// Headless benchmark of the media library, search, sorting, queue & configuration.
+///
+/// Build & run as a separate entry point, against a scratch cache directory & a (e.g. synthetic) library:
+///
+/// ```
+/// python3 scripts/synthetic_library_gen.py /tmp/Library --tracks 20000
+/// flutter build linux --profile -t lib/benchmark.dart
+/// HARMONOID_CACHE_DIRECTORY=$(mktemp -d) build/linux/x64/profile/bundle/harmonoid --library=/tmp/Library --output=benchmark.json
+/// ```
+///
+/// No window is shown; a display (e.g. xvfb-run) is still required by the runner. Timings (in milliseconds) & the peak RSS are written as
+/// JSON to --output (or standard output). Compare two runs with scripts/benchmark_compare.py.
+///
+/// Options:
+/// * --library=PATH: directory to scan; required.
+/// * --output=PATH: file to write the results to.
+/// * --iterations=N: number of samples of each repeated measurement; default 5.
+Future<void> main(List<String> args) async {
+  final options = {
+    for (final arg in args)
+      if (arg.startsWith('--') && arg.contains('=')) arg.substring(2, arg.indexOf('=')): arg.substring(arg.indexOf('=') + 1),
+  };
+  final library = options['library'];
+  final iterations = int.tryParse(options['iterations'] ?? '') ?? 5;
+  if (library == null || Platform.environment['HARMONOID_CACHE_DIRECTORY'] == null) {
+    // NOTE: Refuse to run against the default cache directory; the benchmark must not modify the user's media library or configuration.
+    stderr.writeln('Usage: HARMONOID_CACHE_DIRECTORY=<scratch directory> harmonoid --library=<directory> [--output=<file>] [--iterations=<n>]');
+    exit(64);
+  }
+
+  final benchmark = _Benchmark();
+  try {
+    // Startup, in the order of lib/main.dart.
+
+    await benchmark.measure('startup.WidgetsFlutterBinding', () async => WidgetsFlutterBinding.ensureInitialized());
+    await benchmark.measure('startup.Configuration', Configuration.ensureInitialized);
+    await benchmark.measure('startup.MediaKit', () async => MediaKit.ensureInitialized(libmpv: Configuration.instance.mpvPath.nullIfBlank()));
+    // NOTE: The cache directory is expected to be empty, so this includes the first (cold) scan of the library.
+    await benchmark.measure(
+      'startup.FileSystemMediaLibrary',
+      () => FileSystemMediaLibrary.ensureInitialized(
+        cache: Configuration.instance.directory,
+        directories: {Directory(library)},
+        albumSortType: Configuration.instance.mediaLibraryAlbumSortType,
+        artistSortType: Configuration.instance.mediaLibraryArtistSortType,
+        genreSortType: Configuration.instance.mediaLibraryGenreSortType,
+        trackSortType: Configuration.instance.mediaLibraryTrackSortType,
+        albumSortAscending: Configuration.instance.mediaLibraryAlbumSortAscending,
+        artistSortAscending: Configuration.instance.mediaLibraryArtistSortAscending,
+        genreSortAscending: Configuration.instance.mediaLibraryGenreSortAscending,
+        trackSortAscending: Configuration.instance.mediaLibraryTrackSortAscending,
+        // Synthetic files may be smaller than the configured minimum.
+        minimumFileSize: 0,
+        albumGroupingParameters: Configuration.instance.mediaLibraryAlbumGroupingParameters,
+        hideSecondaryArtists: Configuration.instance.mediaLibraryHideSecondaryArtists,
+      ),
+    );
+    final mediaLibrary = FileSystemMediaLibrary.instance;
+    final items = mediaLibrary.albums.length + mediaLibrary.artists.length + mediaLibrary.genres.length + mediaLibrary.tracks.length;
+    await benchmark.measure('startup.MediaLibrarySearchIndex', () async {
+      await MediaLibrarySearchIndex.ensureInitialized();
+      await _until(() => MediaLibrarySearchIndex.instance.length >= items);
+    });
+    await benchmark.measure('startup.TrackSortIndex', () async {
+      await TrackSortIndex.ensureInitialized();
+      await _until(() => TrackSortIndex.instance.sorted(TrackSortType.title, true) != null);
+    });
+    await benchmark.measure('startup.MediaPlayer', MediaPlayer.ensureInitialized);
+
+    // Configuration.
+
+    await benchmark.measure('configuration.refresh', Configuration.instance.refresh, iterations: iterations);
+
+    // Media library.
+
+    await benchmark.measure('media_library.refresh', () => mediaLibrary.refresh(), iterations: iterations);
+
+    // Search: a prefix, a whole word & a misspelled word of random titles.
+
+    final random = Random(0);
+    final tracks = mediaLibrary.tracks.toList();
+    final words = [for (final track in tracks) ...track.title.split(' ').where((e) => e.length >= MediaLibrarySearchIndex.kFuzzyMinimumLength)];
+    if (words.isNotEmpty) {
+      for (final (name, query) in [
+        ('prefix', (String e) => e.substring(0, 3)),
+        ('word', (String e) => e),
+        ('typo', (String e) => '${e.substring(0, e.length - 2)}${e[e.length - 1]}${e[e.length - 2]}'),
+      ]) {
+        await benchmark.measure('search.$name', () async {
+          MediaLibrarySearchIndex.instance.search(query(words[random.nextInt(words.length)]), limit: 100);
+        }, iterations: iterations * 10);
+      }
+    }
+
+    // Sorting.
+
+    for (final type in AlbumSortType.values) {
+      await benchmark.measure('sort.album.${type.name}', () => mediaLibrary.populate(albumSortType: type, albumSortAscending: !mediaLibrary.albumSortAscending), iterations: iterations);
+    }
+    for (final type in ArtistSortType.values) {
+      await benchmark.measure('sort.artist.${type.name}', () => mediaLibrary.populate(artistSortType: type, artistSortAscending: !mediaLibrary.artistSortAscending), iterations: iterations);
+    }
+    for (final type in GenreSortType.values) {
+      await benchmark.measure('sort.genre.${type.name}', () => mediaLibrary.populate(genreSortType: type, genreSortAscending: !mediaLibrary.genreSortAscending), iterations: iterations);
+    }
+
+    // Queue.
+
+    final playables = tracks.map((e) => e.toPlayable()).toList();
+    if (playables.length >= 2) {
+      await benchmark.measure('queue.open', () => MediaPlayer.instance.open(playables, play: false, mix: false, onOpen: null), iterations: iterations);
+      await benchmark.measure('queue.move', () => MediaPlayer.instance.move(random.nextInt(playables.length), random.nextInt(playables.length)), iterations: iterations * 10);
+    }
+
+    await benchmark.write(
+      options['output'],
+      library: {
+        'directory': library,
+        'albums': mediaLibrary.albums.length,
+        'artists': mediaLibrary.artists.length,
+        'genres': mediaLibrary.genres.length,
+        'tracks': mediaLibrary.tracks.length,
+      },
+    );
+    exit(0);
+  } catch (exception, stacktrace) {
+    debugPrint(exception.toString());
+    debugPrint(stacktrace.toString());
+    exit(1);
+  }
+}
+
+/// Waits until [condition] is satisfied; used for the indexes which are updated in the background.
+Future<void> _until(bool Function() condition, {Duration timeout = const Duration(minutes: 10)}) async {
+  final stopwatch = Stopwatch()..start();
+  while (!condition()) {
+    if (stopwatch.elapsed > timeout) throw TimeoutException('Condition not satisfied.', timeout);
+    await Future.delayed(const Duration(milliseconds: 1));
+  }
+}
+
+class _Benchmark {
+  /// Runs [action] [iterations] times & records the duration of each run under [name].
+  Future<void> measure(String name, FutureOr<void> Function() action, {int iterations = 1}) async {
+    final samples = _samples[name] = <double>[];
+    for (var i = 0; i < iterations; i++) {
+      final stopwatch = Stopwatch()..start();
+      await action();
+      samples.add(stopwatch.elapsedMicroseconds / 1000);
+    }
+    final sorted = [...samples]..sort();
+    stderr.writeln('${name.padRight(40)}${sorted[sorted.length ~/ 2].toStringAsFixed(2).padLeft(12)} ms');
+  }
+
+  /// Writes the results as JSON to [path] (or standard output).
+  Future<void> write(String? path, {required Map<String, Object> library}) async {
+    final results = {
+      for (final MapEntry(key: name, value: samples) in _samples.entries)
+        name: () {
+          final sorted = [...samples]..sort();
+          return {
+            'iterations': samples.length,
+            'min_ms': sorted.first,
+            'median_ms': sorted[sorted.length ~/ 2],
+            'max_ms': sorted.last,
+            'samples_ms': samples,
+          };
+        }(),
+    };
+    final contents = const JsonEncoder.withIndent('  ').convert({
+      'version': 1,
+      'timestamp': DateTime.now().toUtc().toIso8601String(),
+      'platform': Platform.operatingSystem,
+      'platform_version': Platform.operatingSystemVersion,
+      'dart_version': Platform.version,
+      'processors': Platform.numberOfProcessors,
+      'library': library,
+      'results': results,
+      'peak_rss_bytes': ProcessInfo.maxRss,
+    });
+    if (path == null) {
+      stdout.writeln(contents);
+      await stdout.flush();
+    } else {
+      await File(path).writeAsString(contents);
+    }
+  }
+
+  /// Samples (in milliseconds) by name; in the order of measurement.
+  final Map<String, List<double>> _samples = <String, List<double>>{};
+}
@@ -0,0 +1,538 @@
+import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:math';
+import 'dart:typed_data';
+import 'package:crypto/crypto.dart';
+import 'package:flutter/foundation.dart';
+import 'package:media_kit/media_kit.dart' hide Playable, Track;
+import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
+import 'package:path/path.dart';
+import 'package:safe_local_storage/safe_local_storage.dart';
+import 'package:synchronized/synchronized.dart';
+
+import 'package:harmonoid/core/filesystem_media_library.dart';
+import 'package:harmonoid/core/media_player/models/replaygain.dart';
+import 'package:harmonoid/utils/constants.dart';
+
+/// {@template audio_analyzer}
+///
+/// AudioAnalyzer
+/// -------------
+/// Implementation to analyze the tracks of the media library in background.
+///
+/// Tracks are decoded by a pool of [kPooledPlayerSize] headless libmpv instances as fast as possible (untimed), each on its own threads. FFmpeg's ebur128 filter is inserted in the audio filter
+/// chain to measure EBU R128 integrated loudness & sample peak. Results are appended to a journal as each track completes, so the analysis
+/// resumes where it left off.
+///
+/// In the same pass, the audio output writes low sample-rate mono PCM to a temporary file; which is reduced to a [Waveform] on a separate
+/// isolate & persisted per track. [Waveform]s are a few hundred bytes each, so these are read whole when the track changes.
+///
+/// {@endtemplate}
+class AudioAnalyzer {
+  static const String kLoudnessFileName = 'Loudness.BIN';
+  static const String kWaveformsDirectoryName = 'Waveforms';
+
+  /// Sample-rate of the PCM used for computing the [Waveform].
+  static const int kWaveformSampleRate = 8000;
+
+  /// ReplayGain 2.0 reference loudness (in LUFS).
+  static const double kReferenceLoudness = -18.0;
+
+  /// Maximum duration for analyzing a single track.
+  static const Duration kTimeout = Duration(minutes: 5);
+
+  /// Delay between consecutive tracks, keeps the analysis from saturating the system.
+  static const Duration kThrottle = Duration(milliseconds: 500);
+
+  static const String kFilterLabel = 'r128';
+
+  /// Number of headless libmpv instances decoding tracks in parallel while analyzing the media library.
+  static final int kPooledPlayerSize = () {
+    try {
+      // Half of [FileSystemMediaLibrary.kPooledTagReaderSize]; decoding is heavier than tag reading & playback must not be affected.
+      return (FileSystemMediaLibrary.kPooledTagReaderSize ~/ 2).clamp(1, 8);
+    } catch (_) {
+      return 1;
+    }
+  }();
+
+  /// Singleton instance.
+  static final AudioAnalyzer instance = AudioAnalyzer._();
+
+  /// Whether the [instance] is initialized.
+  static bool initialized = false;
+
+  /// {@macro audio_analyzer}
+  AudioAnalyzer._();
+
+  /// Initializes the [instance].
+  static Future<void> ensureInitialized({required Directory directory}) async {
+    if (initialized) return;
+    initialized = true;
+    instance._loudnessFile = File(join(directory.path, kLoudnessFileName));
+    instance._waveformsDirectory = Directory(join(directory.path, kWaveformsDirectoryName));
+    if (!await instance._waveformsDirectory.exists_()) {
+      await instance._waveformsDirectory.create_();
+    }
+    final path = instance._loudnessFile.path;
+    final (loudness, failed) = await Isolate.run(() => _LoudnessJournal.read(path));
+    instance._loudness.addAll(loudness);
+    instance._failed.addAll(failed);
+    FileSystemMediaLibrary.instance.addListener(instance._listener);
+  }
+
+  /// Whether the analysis is running.
+  bool get running => _running;
+
+  /// URIs of the tracks as they are analyzed.
+  Stream<String> get analyzed => _analyzedStreamController.stream;
+
+  /// Returns the [Waveform] of [uri], or null if the [uri] is not analyzed yet.
+  Future<Waveform?> waveform(String uri) async {
+    try {
+      final file = _waveformFileFor(uri);
+      if (!await file.exists_()) return null;
+      return Waveform.decode(await file.readAsBytes());
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+      return null;
+    }
+  }
+
+  /// Analyzes [uri] before the remaining tracks. Starts the analysis (of prioritized tracks only) if not running. Previously failed tracks
+  /// are retried.
+  void prioritize(String uri) {
+    _failed.remove(uri);
+    _prioritized.addFirst(uri);
+    if (!_running) {
+      unawaited(start(library: false));
+    }
+  }
+
+  /// Analyzes [uris] which are not analyzed yet before the remaining tracks. Starts the analysis (of prioritized tracks only) if not running.
+  void enqueue(Iterable<String> uris) {
+    for (final uri in uris) {
+      if (_loudness.containsKey(uri) || _failed.contains(uri) || _prioritized.contains(uri)) continue;
+      _prioritized.add(uri);
+    }
+    if (!_running && _prioritized.isNotEmpty) {
+      unawaited(start(library: false));
+    }
+  }
+
+  /// Returns the gain (in dB) for [uri] based on [replayGain] & [preamp], or null if the [uri] is not analyzed yet.
+  ///
+  /// Album gain is computed from the analyzed tracks of the same album as the duration-weighted energy average of their loudness.
+  double? gain(String uri, ReplayGain replayGain, {double preamp = 0.0}) {
+    final entry = _loudness[uri];
+    if (entry == null || replayGain == ReplayGain.off) return null;
+
+    var loudness = entry.loudness;
+    var peak = entry.peak;
+    if (replayGain == ReplayGain.album) {
+      final track = FileSystemMediaLibrary.instance.lookupTrack(TrackLookupKey(uri: uri));
+      final uris = track == null ? null : _albums[_albumKey(track)];
+      if (uris != null && uris.length > 1) {
+        var energy = 0.0;
+        var duration = 0.0;
+        for (final e in uris.map((e) => _loudness[e]).nonNulls) {
+          energy += e.duration * pow(10.0, e.loudness / 10.0);
+          duration += e.duration;
+          peak = max(peak, e.peak);
+        }
+        if (duration > 0.0) {
+          loudness = 10.0 * log(energy / duration) / ln10;
+        }
+      }
+    }
+    var result = kReferenceLoudness - loudness + preamp;
+    if (peak > 0.0) {
+      // Prevent clipping, same as --replaygain-clip=no.
+      result = min(result, -20.0 * log(peak) / ln10);
+    }
+    return result;
+  }
+
+  /// Starts analyzing the prioritized tracks &, if [library] is true, the tracks of the media library which are not analyzed yet. The
+  /// media library is analyzed by [kPooledPlayerSize] players in parallel, prioritized tracks alone by a single one.
+  Future<void> start({bool library = true}) async {
+    _stopped = false;
+    if (library && _queue.isEmpty) _queue.addAll(_pending());
+    if (!_running) {
+      _running = true;
+      try {
+        // NOTE: Under the lock, so that the workers spawned by a concurrent [start] wait for it.
+        await _journalLock.synchronized(() async => _journal = await _loudnessFile.open(mode: FileMode.append));
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+        _running = false;
+        return;
+      }
+    }
+    debugPrint('AudioAnalyzer: start: Pending: ${_prioritized.length + _queue.length}');
+    _spawn(library ? kPooledPlayerSize : 1);
+  }
+
+  /// Stops the analysis of the media library. Prioritized tracks are still analyzed.
+  void stop() {
+    _queue.clear();
+  }
+
+  /// Stops the analysis after the current tracks.
+  void dispose() {
+    _stopped = true;
+  }
+
+  /// Starts the workers up to [count], which are not running already.
+  void _spawn(int count) {
+    for (var id = 0; id < count; id++) {
+      if (_workers.add(id)) {
+        unawaited(_worker(id));
+      }
+    }
+  }
+
+  /// Analyzes the queued tracks one at a time with its own player & PCM file, until the queues are empty or the analysis is stopped.
+  Future<void> _worker(int id) async {
+    final pcm = File(join(Directory.systemTemp.path, 'Harmonoid-AudioAnalyzer-$pid-$id.PCM'));
+    Player? player;
+    try {
+      player = Player(configuration: const PlayerConfiguration(title: kTitle));
+      final platform = player.platform as dynamic;
+      await platform.setProperty('vid', 'no');
+      await platform.setProperty('ao', 'pcm');
+      await platform.setProperty('ao-pcm-file', pcm.path);
+      await platform.setProperty('ao-pcm-waveheader', 'no');
+      await platform.setProperty('audio-format', 's16');
+      await platform.setProperty('audio-channels', 'mono');
+      await platform.setProperty('audio-samplerate', '$kWaveformSampleRate');
+      // NOTE: Re-create the audio output for every track, so that the PCM file is closed (flushed) & truncated.
+      await platform.setProperty('gapless-audio', 'no');
+      await platform.setProperty('untimed', 'yes');
+      await platform.setProperty('keep-open', 'yes');
+      await platform.setProperty('replaygain', 'no');
+      await platform.setProperty('af', '@$kFilterLabel:lavfi=[ebur128=metadata=1:peak=sample]');
+
+      while (_prioritized.isNotEmpty || _queue.isNotEmpty) {
+        while (FileSystemMediaLibrary.instance.refreshing && !_stopped) {
+          await Future.delayed(kThrottle);
+        }
+        if (_stopped) break;
+
+        final uri = _prioritized.isNotEmpty ? _prioritized.removeFirst() : _queue.removeFirst();
+        // Being analyzed by another worker.
+        if (_active.contains(uri)) continue;
+        if (_failed.contains(uri) || (_loudness.containsKey(uri) && await _waveformFileFor(uri).exists_())) continue;
+
+        _active.add(uri);
+        try {
+          final entry = await _analyze(player, pcm, uri);
+          if (entry == null) {
+            // NOTE: Recorded, so that failed or silent tracks are not decoded again upon every launch; [prioritize] retries these.
+            _failed.add(uri);
+          } else {
+            _loudness[uri] = entry;
+          }
+          await _journalLock.synchronized(() async {
+            await _journal?.writeFrom(_LoudnessJournal.encode(uri, entry));
+            await _journal?.flush();
+          });
+          _analyzedStreamController.add(uri);
+        } finally {
+          _active.remove(uri);
+        }
+
+        await Future.delayed(kThrottle);
+      }
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+    } finally {
+      try {
+        await player?.dispose();
+        await pcm.delete_();
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+      _workers.remove(id);
+      if (!_stopped && (_prioritized.isNotEmpty || _queue.isNotEmpty) && _workers.isEmpty) {
+        // Enqueued while this worker was exiting.
+        _spawn(1);
+      } else if (_workers.isEmpty) {
+        // NOTE: [_prioritized] is retained; it is processed upon the next [start].
+        _queue.clear();
+        _running = false;
+        // NOTE: Detached first; a subsequent [start] opens its own.
+        final journal = _journal;
+        _journal = null;
+        await _journalLock.synchronized(() => journal?.close());
+      }
+    }
+  }
+
+  Future<_Loudness?> _analyze(Player player, File pcm, String uri) async {
+    try {
+      final platform = player.platform as dynamic;
+      final completed = player.stream.completed.firstWhere((e) => e);
+      await pcm.delete_();
+      await player.open(Media(uri), play: true);
+      await completed.timeout(kTimeout);
+
+      final metadata = Map<String, dynamic>.from(jsonDecode(await platform.getProperty('af-metadata/$kFilterLabel')));
+      final loudness = double.tryParse('${metadata['lavfi.r128.I']}');
+      final peak = double.tryParse('${metadata['lavfi.r128.sample_peak']}') ?? 0.0;
+      final duration = player.state.duration.inMilliseconds / 1000.0;
+      await player.stop();
+
+      final path = pcm.path;
+      final waveform = await Isolate.run(() => Waveform.compute(path));
+      if (waveform != null) {
+        await _waveformFileFor(uri).write_(waveform.encode());
+      }
+
+      // NOTE: ebur128 reports -70.0 LUFS (absolute gate) for silence.
+      if (loudness == null || loudness <= -70.0) return null;
+
+      debugPrint('AudioAnalyzer: _analyze: $uri: $loudness LUFS, $peak');
+      return _Loudness(loudness: loudness, peak: peak, duration: duration);
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+      try {
+        await player.stop();
+      } catch (_) {}
+      return null;
+    }
+  }
+
+  void _listener() {
+    final generation = FileSystemMediaLibrary.instance.generation(MediaLibraryCollection.tracks);
+    if (_generation == generation) return;
+    _generation = generation;
+    _albumsCache = null;
+  }
+
+  /// Track URIs grouped by album. Re-computed lazily after the media library changes.
+  Map<String, Set<String>> get _albums {
+    return _albumsCache ??= () {
+      final result = HashMap<String, Set<String>>();
+      for (final track in FileSystemMediaLibrary.instance.tracks) {
+        result.putIfAbsent(_albumKey(track), () => <String>{}).add(track.uri);
+      }
+      return result;
+    }();
+  }
+
+  Iterable<String> _pending() => FileSystemMediaLibrary.instance.tracks.map((e) => e.uri).where((e) => !_loudness.containsKey(e) && !_failed.contains(e));
+
+  String _albumKey(Track track) => '${track.album}\u0000${track.albumArtist}';
+
+  File _waveformFileFor(String uri) => File(join(_waveformsDirectory.path, '${sha256.convert(utf8.encode(uri))}.PEAKS'));
+
+  /// Journal file.
+  late final File _loudnessFile;
+
+  /// Directory where [Waveform]s are stored.
+  late final Directory _waveformsDirectory;
+
+  /// Currently opened journal file (for appending).
+  RandomAccessFile? _journal;
+
+  /// Mutual exclusion in [_journal] writes by the workers.
+  final Lock _journalLock = Lock();
+
+  /// IDs of the running workers.
+  final HashSet<int> _workers = HashSet<int>();
+
+  /// URIs being analyzed by the workers.
+  final HashSet<String> _active = HashSet<String>();
+
+  /// URIs pending analysis.
+  final ListQueue<String> _queue = ListQueue<String>();
+
+  /// URIs pending analysis before [_queue].
+  final ListQueue<String> _prioritized = ListQueue<String>();
+
+  final StreamController<String> _analyzedStreamController = StreamController<String>.broadcast();
+
+  /// Analyzed tracks keyed by URI.
+  final HashMap<String, _Loudness> _loudness = HashMap<String, _Loudness>();
+
+  /// URIs which could not be analyzed (or are silent).
+  final Set<String> _failed = HashSet<String>();
+
+  Map<String, Set<String>>? _albumsCache;
+
+  /// [FileSystemMediaLibrary.generation] of the tracks at the last notification.
+  int? _generation;
+
+  bool _running = false;
+  bool _stopped = false;
+}
+
+/// {@template waveform}
+///
+/// Waveform
+/// --------
+/// Downsampled envelope of a track: minimum, maximum & RMS of the samples in each of [kResolution] equal segments.
+///
+/// Encoded as [kResolution] records of (int8 minimum, int8 maximum, uint8 RMS).
+///
+/// {@endtemplate}
+class Waveform {
+  /// Number of segments.
+  static const int kResolution = 256;
+
+  /// Minimum sample in each segment.
+  final Int8List minimums;
+
+  /// Maximum sample in each segment.
+  final Int8List maximums;
+
+  /// RMS of the samples in each segment.
+  final Uint8List rms;
+
+  /// {@macro waveform}
+  const Waveform({
+    required this.minimums,
+    required this.maximums,
+    required this.rms,
+  });
+
+  /// Normalized (0.0 to 1.0) absolute peak in each segment.
+  List<double> get peaks => List<double>.generate(minimums.length, (i) => max(-minimums[i], maximums[i]) / 128.0, growable: false);
+
+  Uint8List encode() {
+    final result = Uint8List(minimums.length * 3);
+    for (var i = 0; i < minimums.length; i++) {
+      result[i * 3] = minimums[i] & 0xFF;
+      result[i * 3 + 1] = maximums[i] & 0xFF;
+      result[i * 3 + 2] = rms[i];
+    }
+    return result;
+  }
+
+  static Waveform? decode(Uint8List bytes) {
+    if (bytes.isEmpty || bytes.length % 3 != 0) return null;
+    final n = bytes.length ~/ 3;
+    final minimums = Int8List(n);
+    final maximums = Int8List(n);
+    final rms = Uint8List(n);
+    final data = Int8List.sublistView(bytes);
+    for (var i = 0; i < n; i++) {
+      minimums[i] = data[i * 3];
+      maximums[i] = data[i * 3 + 1];
+      rms[i] = bytes[i * 3 + 2];
+    }
+    return Waveform(minimums: minimums, maximums: maximums, rms: rms);
+  }
+
+  /// Computes the [Waveform] from raw signed 16-bit little endian mono PCM at [path].
+  ///
+  /// Runs inside a separate isolate.
+  static Waveform? compute(String path) {
+    final file = File(path);
+    if (!file.existsSync()) return null;
+    final bytes = file.readAsBytesSync();
+    final samples = bytes.lengthInBytes ~/ 2;
+    if (samples < kResolution) return null;
+    final data = ByteData.sublistView(bytes);
+
+    final minimums = Int8List(kResolution);
+    final maximums = Int8List(kResolution);
+    final rms = Uint8List(kResolution);
+    for (var i = 0; i < kResolution; i++) {
+      final start = i * samples ~/ kResolution;
+      final end = (i + 1) * samples ~/ kResolution;
+      var lo = 0;
+      var hi = 0;
+      var sum = 0.0;
+      for (var j = start; j < end; j++) {
+        final sample = data.getInt16(j * 2, Endian.little);
+        if (sample < lo) lo = sample;
+        if (sample > hi) hi = sample;
+        sum += sample * sample;
+      }
+      minimums[i] = lo >> 8;
+      maximums[i] = hi >> 8;
+      rms[i] = (sqrt(sum / max(1, end - start)) / 128.0).round().clamp(0, 255);
+    }
+    return Waveform(minimums: minimums, maximums: maximums, rms: rms);
+  }
+}
+
+class _Loudness {
+  /// Integrated loudness (in LUFS).
+  final double loudness;
+
+  /// Sample peak (linear).
+  final double peak;
+
+  /// Duration (in seconds).
+  final double duration;
+
+  const _Loudness({
+    required this.loudness,
+    required this.peak,
+    required this.duration,
+  });
+}
+
+/// Each record (little endian): uint16 length, utf8 uri, float32 loudness, float32 peak, float32 duration. A NaN loudness marks a track
+/// which could not be analyzed (or is silent). Records are only ever appended; a later record for the same URI supersedes an earlier one.
+abstract class _LoudnessJournal {
+  /// Encodes the record of [uri]; a null [entry] marks the track as failed.
+  static Uint8List encode(String uri, _Loudness? entry) {
+    final bytes = utf8.encode(uri);
+    final data = ByteData(2 + bytes.length + 12);
+    data.setUint16(0, bytes.length, Endian.little);
+    data.buffer.asUint8List().setRange(2, 2 + bytes.length, bytes);
+    data.setFloat32(2 + bytes.length, entry?.loudness ?? double.nan, Endian.little);
+    data.setFloat32(6 + bytes.length, entry?.peak ?? 0.0, Endian.little);
+    data.setFloat32(10 + bytes.length, entry?.duration ?? 0.0, Endian.little);
+    return data.buffer.asUint8List();
+  }
+
+  /// Replays the journal at [path]. Returns the analyzed & failed tracks.
+  static (Map<String, _Loudness>, Set<String>) read(String path) {
+    final result = HashMap<String, _Loudness>();
+    final failed = HashSet<String>();
+    final file = File(path);
+    if (!file.existsSync()) return (result, failed);
+    final bytes = file.readAsBytesSync();
+    final data = ByteData.sublistView(bytes);
+    var offset = 0;
+    // NOTE: A partially written record at the end (e.g. power loss) is ignored.
+    while (offset + 2 <= bytes.length) {
+      final length = data.getUint16(offset, Endian.little);
+      if (offset + 2 + length + 12 > bytes.length) break;
+      final uri = utf8.decode(Uint8List.sublistView(bytes, offset + 2, offset + 2 + length), allowMalformed: true);
+      final loudness = data.getFloat32(offset + 2 + length, Endian.little);
+      if (loudness.isNaN) {
+        result.remove(uri);
+        failed.add(uri);
+      } else {
+        result[uri] = _Loudness(
+          loudness: loudness,
+          peak: data.getFloat32(offset + 6 + length, Endian.little),
+          duration: data.getFloat32(offset + 10 + length, Endian.little),
+        );
+        failed.remove(uri);
+      }
+      offset += 2 + length + 12;
+    }
+    if (offset < bytes.length) {
+      // Drop the incomplete record, so that subsequent records are appended after a valid one.
+      final raf = file.openSync(mode: FileMode.append);
+      raf.truncateSync(offset);
+      raf.closeSync();
+    }
+    return (result, failed);
+  }
+}
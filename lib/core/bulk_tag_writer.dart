@@ -0,0 +1,225 @@
+import 'dart:async';
+import 'dart:io';
+import 'dart:isolate';
+import 'package:flutter/foundation.dart';
+import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
+import 'package:path/path.dart';
+import 'package:pool/pool.dart';
+import 'package:safe_local_storage/safe_local_storage.dart';
+import 'package:synchronized/synchronized.dart';
+import 'package:taglib/taglib.dart';
+import 'package:uuid/uuid.dart';
+
+import 'package:harmonoid/core/filesystem_media_library.dart';
+import 'package:harmonoid/core/media_library_watcher.dart';
+import 'package:harmonoid/mappers/media_library_item.dart';
+import 'package:harmonoid/utils/async_file_image.dart';
+
+/// {@template bulk_tag_writer}
+///
+/// BulkTagWriter
+/// -------------
+/// Implementation to write tags to many files at once.
+///
+/// [apply] works in three phases:
+/// 1. Each file is copied to a temporary file in the same directory & the edit is written to the copy. [kConcurrency] files are written at a
+///    time, each on a separate isolate. If any of them fail, the copies are deleted & no file is modified.
+/// 2. The copies are renamed over the original files. Each rename is atomic, but the set is not: if one fails, the files renamed before
+///    it remain modified.
+/// 3. The media library is updated once for all the modified files (see [reload]).
+///
+/// Phases 2 & 3 run with [MediaLibraryWatcher] suspended, which then records the modified files; so these are not re-read again upon
+/// the resulting change notifications.
+///
+/// {@endtemplate}
+class BulkTagWriter {
+  static final int kConcurrency = () {
+    try {
+      // Leave one processor for the UI isolate.
+      return (Platform.numberOfProcessors - 1).clamp(2, 16);
+    } catch (_) {
+      return 2;
+    }
+  }();
+
+  /// Prefix of the temporary files; these are hidden & ignored by the media library watcher.
+  static const String kTemporaryFilePrefix = '.Harmonoid-';
+
+  /// Singleton instance.
+  static final BulkTagWriter instance = BulkTagWriter._();
+
+  /// {@macro bulk_tag_writer}
+  BulkTagWriter._();
+
+  /// Applies [edits]; [onProgress] is invoked as files are written, renamed & re-read. Throws if any file could not be written, in which case
+  /// no file is modified; or if any file could not be renamed, in which case the remaining files are still modified & re-read.
+  Future<void> apply(List<TagEdit> edits, {void Function(BulkTagWriterProgress progress)? onProgress}) {
+    return _lock.synchronized(() async {
+      final stopwatch = Stopwatch()..start();
+      final total = edits.length;
+
+      // 1. Write.
+
+      final temporaries = [for (final edit in edits) join(dirname(edit.uri), '$kTemporaryFilePrefix${const Uuid().v4()}${extension(edit.uri)}')];
+      Object? error;
+      StackTrace? stacktrace;
+      var completed = 0;
+      onProgress?.call(BulkTagWriterProgress(BulkTagWriterPhase.write, 0, total));
+      final pool = Pool(kConcurrency);
+      await Future.wait(
+        List.generate(
+          total,
+          (i) => pool.withResource(() async {
+            // Stop at the first failure.
+            if (error != null) return;
+            try {
+              await _write(edits[i], temporaries[i]);
+              onProgress?.call(BulkTagWriterProgress(BulkTagWriterPhase.write, ++completed, total));
+            } catch (exception, s) {
+              error ??= exception;
+              stacktrace ??= s;
+            }
+          }),
+        ),
+      );
+      await pool.close();
+      if (error != null) {
+        for (final temporary in temporaries) {
+          await File(temporary).delete_();
+        }
+        Error.throwWithStackTrace(error!, stacktrace!);
+      }
+
+      final committed = <String>[];
+      await MediaLibraryWatcher.instance.suspend(() async {
+        // 2. Commit.
+
+        completed = 0;
+        for (var i = 0; i < total; i++) {
+          try {
+            await File(temporaries[i]).rename(edits[i].uri);
+            committed.add(edits[i].uri);
+          } catch (exception, s) {
+            debugPrint(exception.toString());
+            debugPrint(s.toString());
+            error ??= exception;
+            stacktrace ??= s;
+            await File(temporaries[i]).delete_();
+          }
+          onProgress?.call(BulkTagWriterProgress(BulkTagWriterPhase.commit, ++completed, total));
+        }
+
+        // 3. Reload.
+
+        await reload(committed, onProgress: onProgress);
+        return committed;
+      });
+
+      debugPrint('BulkTagWriter: apply: Files: ${committed.length}/$total, Elapsed: ${stopwatch.elapsedMilliseconds} ms');
+      if (error != null) {
+        Error.throwWithStackTrace(error!, stacktrace!);
+      }
+    });
+  }
+
+  /// Updates the media library, playlists & covers after the tags of [uris] were modified. Invoked by [apply].
+  Future<void> reload(List<String> uris, {void Function(BulkTagWriterProgress progress)? onProgress}) async {
+    final mediaLibrary = FileSystemMediaLibrary.instance;
+    final total = uris.length;
+    var completed = 0;
+    onProgress?.call(BulkTagWriterProgress(BulkTagWriterPhase.reload, 0, total));
+
+    final originals = <String, Track>{};
+    for (final uri in uris) {
+      final track = mediaLibrary.lookupTrack(TrackLookupKey(uri: uri));
+      if (track == null) continue;
+      originals[uri] = track;
+      AsyncFileImage.reset(track.toImageKey());
+      await MediaLibrary.trackUriToCoverFile(mediaLibrary.covers, uri).delete_();
+    }
+    if (originals.isEmpty) return;
+
+    // Removed together & re-added as many at a time as there are tag readers, then sorted & aggregated once.
+    await mediaLibrary.remove(originals.values.toList(), delete: false);
+    final pool = Pool(FileSystemMediaLibrary.kPooledTagReaderSize);
+    await Future.wait(
+      originals.keys.map(
+        (e) => pool.withResource(() async {
+          try {
+            await mediaLibrary.add(File(e));
+          } catch (exception, stacktrace) {
+            debugPrint(exception.toString());
+            debugPrint(stacktrace.toString());
+          }
+          onProgress?.call(BulkTagWriterProgress(BulkTagWriterPhase.reload, ++completed, total));
+        }),
+      ),
+    );
+    await pool.close();
+    await mediaLibrary.populate();
+
+    for (final MapEntry(key: uri, value: original) in originals.entries) {
+      final track = mediaLibrary.lookupTrack(TrackLookupKey(uri: uri));
+      if (track == null) continue;
+      await mediaLibrary.playlists.replaceHash(HashEncoder.trackToHash(original), HashEncoder.trackToHash(track));
+    }
+  }
+
+  // NOTE: Static, so that the closure sent to the isolate only captures the arguments.
+
+  /// Copies the file of [edit] to [temporary] & writes [edit] to it.
+  static Future<void> _write(TagEdit edit, String temporary) {
+    return Isolate.run(() async {
+      File(edit.uri).copySync(temporary);
+      final file = TagLibFile(temporary);
+      try {
+        for (final MapEntry(:key, :value) in edit.properties.entries) {
+          if (value == null || value.trim().isEmpty) {
+            await file.removeProperty(key);
+          } else {
+            await file.setProperty(key, [value.trim()]);
+          }
+        }
+        if (edit.cover != null) {
+          await file.setCover(edit.cover!);
+        } else if (edit.removeCover) {
+          await file.removeCover();
+        }
+        await file.save();
+      } finally {
+        await file.dispose();
+      }
+    });
+  }
+
+  final Lock _lock = Lock();
+}
+
+/// Edit of the tags of a file.
+class TagEdit {
+  /// URI of the file.
+  final String uri;
+
+  /// Properties to set; null or empty values remove the property.
+  final Map<String, String?> properties;
+
+  /// Cover to set.
+  final CoverData? cover;
+
+  /// Whether to remove the cover; ignored if [cover] is set.
+  final bool removeCover;
+
+  const TagEdit({required this.uri, this.properties = const {}, this.cover, this.removeCover = false});
+}
+
+/// Phase of [BulkTagWriter.apply].
+enum BulkTagWriterPhase { write, commit, reload }
+
+/// Progress of [BulkTagWriter.apply].
+class BulkTagWriterProgress {
+  final BulkTagWriterPhase phase;
+  final int completed;
+  final int total;
+
+  const BulkTagWriterProgress(this.phase, this.completed, this.total);
+}
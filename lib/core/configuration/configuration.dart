@@ -1,3 +1,4 @@
+import 'dart:convert';
 import 'dart:io';
 import 'package:adaptive_layouts/adaptive_layouts.dart';
 import 'package:collection/collection.dart';
@@ -70,88 +71,96 @@ class Configuration extends ConfigurationBase {
 
   /// Refreshes the loaded values.
   Future<void> refresh() async {
-    // Insert default values if any key is absent.
     final defaults = await getDefaults();
+    final entries = await db.getAll();
+
+    // Insert default values if any key is absent.
+    final absent = <Entry>[];
     for (final entry in defaults.entries) {
       final key = entry.key;
       final value = entry.value;
+      if (entries.containsKey(key)) continue;
       if (value is bool) {
-        await db.setValueIfAbsent(key, kTypeBoolean, booleanValue: value);
+        absent.add(Database.createEntry(key, kTypeBoolean, booleanValue: value));
       } else if (value is int) {
-        await db.setValueIfAbsent(key, kTypeInteger, integerValue: value);
+        absent.add(Database.createEntry(key, kTypeInteger, integerValue: value));
       } else if (value is double) {
-        await db.setValueIfAbsent(key, kTypeDouble, doubleValue: value);
+        absent.add(Database.createEntry(key, kTypeDouble, doubleValue: value));
       } else if (value is String) {
-        await db.setValueIfAbsent(key, kTypeString, stringValue: value);
+        absent.add(Database.createEntry(key, kTypeString, stringValue: value));
       } else {
-        await db.setValueIfAbsent(key, kTypeJson, jsonValue: value);
+        absent.add(Database.createEntry(key, kTypeJson, jsonValue: value));
       }
     }
+    if (absent.isNotEmpty) {
+      await db.setEntriesIfAbsent(absent);
+      entries.addAll({for (final entry in absent) entry.key: entry});
+    }
 
-    _apiBaseUrl = await read<String, String>(kKeyApiBaseUrl, defaults);
-    _desktopMediaLibraryFoldersScreenColumnWidths = await read<dynamic, List<double>>(kKeyDesktopMediaLibraryFoldersScreenColumnWidths, defaults, (value) => List<double>.from(value));
-    _desktopMediaLibraryTracksScreenColumnWidths = await read<dynamic, List<double>>(kKeyDesktopMediaLibraryTracksScreenColumnWidths, defaults, (value) => List<double>.from(value));
-    _desktopNowPlayingBarColorPalette = await read<bool, bool>(kKeyDesktopNowPlayingBarColorPalette, defaults);
-    _desktopNowPlayingCarousel = await read<int, int>(kKeyDesktopNowPlayingCarousel, defaults);
-    _desktopNowPlayingLyrics = await read<bool, bool>(kKeyDesktopNowPlayingLyrics, defaults);
-    _discordRpc = await read<bool, bool>(kKeyDiscordRpc, defaults);
-    _identifier = await read<String, String>(kKeyIdentifier, defaults);
-    _lastfmSession = await read<dynamic, Session>(kKeyLastfmSession, defaults, (value) => Session.fromJson(value));
-    _localization = await read<dynamic, LocalizationData>(kKeyLocalization, defaults, (value) => LocalizationData.fromJson(value));
-    _lrcFromDirectory = await read<bool, bool>(kKeyLrcFromDirectory, defaults);
-    _lyricsTranslationLanguage = await read<dynamic, Language>(kKeyLyricsTranslationLanguage, defaults, (value) => Language.fromJson(value));
-    _lyricsViewFocusedFontSize = await read<double, double>(kKeyLyricsViewFocusedFontSize, defaults);
-    _lyricsViewFocusedLineHeight = await read<double, double>(kKeyLyricsViewFocusedLineHeight, defaults);
-    _lyricsViewFontFamily = await read<String, String>(kKeyLyricsViewFontFamily, defaults);
-    _lyricsViewTextAlign = await read<int, TextAlign>(kKeyLyricsViewTextAlign, defaults, (value) => TextAlign.values[value]);
-    _lyricsViewUnfocusedFontSize = await read<double, double>(kKeyLyricsViewUnfocusedFontSize, defaults);
-    _lyricsViewUnfocusedLineHeight = await read<double, double>(kKeyLyricsViewUnfocusedLineHeight, defaults);
-    _mediaLibraryAddPlaylistToNowPlaying = await read<bool, bool>(kKeyMediaLibraryAddPlaylistToNowPlaying, defaults);
-    _mediaLibraryAlbumGroupingParameters = await read<dynamic, Set<AlbumGroupingParameter>>(kKeyMediaLibraryAlbumGroupingParameters, defaults, (value) => value.map<AlbumGroupingParameter>((e) => AlbumGroupingParameter.values[e]).toSet());
-    _mediaLibraryAlbumSortAscending = await read<bool, bool>(kKeyMediaLibraryAlbumSortAscending, defaults);
-    _mediaLibraryAlbumSortType = await read<int, AlbumSortType>(kKeyMediaLibraryAlbumSortType, defaults, (value) => AlbumSortType.values[value]);
-    _mediaLibraryArtistImages = await read<bool, bool>(kKeyMediaLibraryArtistImages, defaults);
-    _mediaLibraryArtistSortAscending = await read<bool, bool>(kKeyMediaLibraryArtistSortAscending, defaults);
-    _mediaLibraryArtistSortType = await read<int, ArtistSortType>(kKeyMediaLibraryArtistSortType, defaults, (value) => ArtistSortType.values[value]);
-    _mediaLibraryCoverFallback = await read<bool, bool>(kKeyMediaLibraryCoverFallback, defaults);
-    _mediaLibraryDirectories = await read<dynamic, Set<Directory>>(kKeyMediaLibraryDirectories, defaults, (value) => value.map<Directory>((e) => Directory(e)).toSet());
-    _mediaLibraryFolderFileExplorerShowHiddenFiles = await read<bool, bool>(kKeyMediaLibraryFolderFileExplorerShowHiddenFiles, defaults);
-    _mediaLibraryFolderFileExplorerSortAscending = await read<bool, bool>(kKeyMediaLibraryFolderFileExplorerSortAscending, defaults);
-    _mediaLibraryFolderFileExplorerSortType = await read<int, FileExplorerSortType>(kKeyMediaLibraryFolderFileExplorerSortType, defaults, (value) => FileExplorerSortType.values[value]);
-    _mediaLibraryFolderFileExplorerViewType = await read<int, FileExplorerViewType>(kKeyMediaLibraryFolderFileExplorerViewType, defaults, (value) => FileExplorerViewType.values[value]);
-    _mediaLibraryGenreSortAscending = await read<bool, bool>(kKeyMediaLibraryGenreSortAscending, defaults);
-    _mediaLibraryGenreSortType = await read<int, GenreSortType>(kKeyMediaLibraryGenreSortType, defaults, (value) => GenreSortType.values[value]);
-    _mediaLibraryHideSecondaryArtists = await read<bool, bool>(kKeyMediaLibraryHideSecondaryArtists, defaults);
-    _mediaLibraryMinimumFileSize = await read<int, int>(kKeyMediaLibraryMinimumFileSize, defaults);
-    _mediaLibraryPath = await read<String, String>(kKeyMediaLibraryPath, defaults);
-    _mediaLibraryRefreshUponStart = await read<bool, bool>(kKeyMediaLibraryRefreshUponStart, defaults);
-    _mediaLibraryTrackSortAscending = await read<bool, bool>(kKeyMediaLibraryTrackSortAscending, defaults);
-    _mediaLibraryTrackSortType = await read<int, TrackSortType>(kKeyMediaLibraryTrackSortType, defaults, (value) => TrackSortType.values[value]);
-    _mediaLibraryTrackViewType = await read<int, TrackViewType>(kKeyMediaLibraryTrackViewType, defaults, (value) => TrackViewType.values[value]);
-    _mediaLibraryVisibleTabs = await read<dynamic, Set<MediaLibraryTab>>(kKeyMediaLibraryVisibleTabs, defaults, (value) => value.map<MediaLibraryTab>((e) => MediaLibraryTab.values[e]).toSet());
-    _mediaPlayerPlaybackState = await read<dynamic, PlaybackState>(kKeyMediaPlayerPlaybackState, defaults, (value) => PlaybackState.fromJson(value));
-    _metaInstallDate = await read<String, String>(kKeyMetaInstallDate, defaults);
-    _metaInAppReviewSubmitted = await read<bool, bool>(kKeyMetaInAppReviewSubmitted, defaults);
-    _metaLaunchCount = await read<int, int>(kKeyMetaLaunchCount, defaults);
-    _mobileMediaLibraryAlbumScrollViewBuilderSpan = await read<int, int>(kKeyMobileMediaLibraryAlbumScrollViewBuilderSpan, defaults);
-    _mobileMediaLibraryArtistScrollViewBuilderSpan = await read<int, int>(kKeyMobileMediaLibraryArtistScrollViewBuilderSpan, defaults);
-    _mobileMediaLibraryGenreScrollViewBuilderSpan = await read<int, int>(kKeyMobileMediaLibraryGenreScrollViewBuilderSpan, defaults);
-    _mobileNotificationLyricsHidden = await read<bool, bool>(kKeyMobileNotificationLyricsHidden, defaults);
-    _mobileNowPlayingLyricsFtux = await read<int, int>(kKeyMobileNowPlayingLyricsFtux, defaults);
-    _mobileNowPlayingRipple = await read<bool, bool>(kKeyMobileNowPlayingRipple, defaults);
-    _mobileNowPlayingVolumeSlider = await read<bool, bool>(kKeyMobileNowPlayingVolumeSlider, defaults);
-    _mpvOptions = await read<dynamic, Map<String, String>>(kKeyMpvOptions, defaults, (value) => Map<String, String>.from(value));
-    _mpvPath = await read<String, String>(kKeyMpvPath, defaults);
-    _notificationLyrics = await read<bool, bool>(kKeyNotificationLyrics, defaults);
-    _nowPlayingAudioFormat = await read<bool, bool>(kKeyNowPlayingAudioFormat, defaults);
-    _nowPlayingDisplayUponPlay = await read<bool, bool>(kKeyNowPlayingDisplayUponPlay, defaults);
-    _nowPlayingStartMixAfterEnding = await read<bool, bool>(kKeyNowPlayingStartMixAfterEnding, defaults);
-    _themeAnimationDuration = await read<dynamic, AnimationDuration>(kKeyThemeAnimationDuration, defaults, (value) => AnimationDuration.fromJson(value));
-    _themeMaterialStandard = await read<int, int>(kKeyThemeMaterialStandard, defaults);
-    _themeMode = await read<int, ThemeMode>(kKeyThemeMode, defaults, (value) => ThemeMode.values[value]);
-    _themeSystemColorScheme = await read<bool, bool>(kKeyThemeSystemColorScheme, defaults);
-    _updateCheckVersion = await read<String, String>(kKeyUpdateCheckVersion, defaults);
-    _windowsTaskbarProgress = await read<bool, bool>(kKeyWindowsTaskbarProgress, defaults);
+    _apiBaseUrl = read<String, String>(kKeyApiBaseUrl, entries, defaults);
+    _desktopMediaLibraryFoldersScreenColumnWidths = read<dynamic, List<double>>(kKeyDesktopMediaLibraryFoldersScreenColumnWidths, entries, defaults, (value) => List<double>.from(value));
+    _desktopMediaLibraryTracksScreenColumnWidths = read<dynamic, List<double>>(kKeyDesktopMediaLibraryTracksScreenColumnWidths, entries, defaults, (value) => List<double>.from(value));
+    _desktopNowPlayingBarColorPalette = read<bool, bool>(kKeyDesktopNowPlayingBarColorPalette, entries, defaults);
+    _desktopNowPlayingCarousel = read<int, int>(kKeyDesktopNowPlayingCarousel, entries, defaults);
+    _desktopNowPlayingLyrics = read<bool, bool>(kKeyDesktopNowPlayingLyrics, entries, defaults);
+    _discordRpc = read<bool, bool>(kKeyDiscordRpc, entries, defaults);
+    _identifier = read<String, String>(kKeyIdentifier, entries, defaults);
+    _lastfmSession = read<dynamic, Session>(kKeyLastfmSession, entries, defaults, (value) => Session.fromJson(value));
+    _localization = read<dynamic, LocalizationData>(kKeyLocalization, entries, defaults, (value) => LocalizationData.fromJson(value));
+    _lrcFromDirectory = read<bool, bool>(kKeyLrcFromDirectory, entries, defaults);
+    _lyricsTranslationLanguage = read<dynamic, Language>(kKeyLyricsTranslationLanguage, entries, defaults, (value) => Language.fromJson(value));
+    _lyricsViewFocusedFontSize = read<double, double>(kKeyLyricsViewFocusedFontSize, entries, defaults);
+    _lyricsViewFocusedLineHeight = read<double, double>(kKeyLyricsViewFocusedLineHeight, entries, defaults);
+    _lyricsViewFontFamily = read<String, String>(kKeyLyricsViewFontFamily, entries, defaults);
+    _lyricsViewTextAlign = read<int, TextAlign>(kKeyLyricsViewTextAlign, entries, defaults, (value) => TextAlign.values[value]);
+    _lyricsViewUnfocusedFontSize = read<double, double>(kKeyLyricsViewUnfocusedFontSize, entries, defaults);
+    _lyricsViewUnfocusedLineHeight = read<double, double>(kKeyLyricsViewUnfocusedLineHeight, entries, defaults);
+    _mediaLibraryAddPlaylistToNowPlaying = read<bool, bool>(kKeyMediaLibraryAddPlaylistToNowPlaying, entries, defaults);
+    _mediaLibraryAlbumGroupingParameters = read<dynamic, Set<AlbumGroupingParameter>>(kKeyMediaLibraryAlbumGroupingParameters, entries, defaults, (value) => value.map<AlbumGroupingParameter>((e) => AlbumGroupingParameter.values[e]).toSet());
+    _mediaLibraryAlbumSortAscending = read<bool, bool>(kKeyMediaLibraryAlbumSortAscending, entries, defaults);
+    _mediaLibraryAlbumSortType = read<int, AlbumSortType>(kKeyMediaLibraryAlbumSortType, entries, defaults, (value) => AlbumSortType.values[value]);
+    _mediaLibraryArtistImages = read<bool, bool>(kKeyMediaLibraryArtistImages, entries, defaults);
+    _mediaLibraryArtistSortAscending = read<bool, bool>(kKeyMediaLibraryArtistSortAscending, entries, defaults);
+    _mediaLibraryArtistSortType = read<int, ArtistSortType>(kKeyMediaLibraryArtistSortType, entries, defaults, (value) => ArtistSortType.values[value]);
+    _mediaLibraryCoverFallback = read<bool, bool>(kKeyMediaLibraryCoverFallback, entries, defaults);
+    _mediaLibraryDirectories = read<dynamic, Set<Directory>>(kKeyMediaLibraryDirectories, entries, defaults, (value) => value.map<Directory>((e) => Directory(e)).toSet());
+    _mediaLibraryFolderFileExplorerShowHiddenFiles = read<bool, bool>(kKeyMediaLibraryFolderFileExplorerShowHiddenFiles, entries, defaults);
+    _mediaLibraryFolderFileExplorerSortAscending = read<bool, bool>(kKeyMediaLibraryFolderFileExplorerSortAscending, entries, defaults);
+    _mediaLibraryFolderFileExplorerSortType = read<int, FileExplorerSortType>(kKeyMediaLibraryFolderFileExplorerSortType, entries, defaults, (value) => FileExplorerSortType.values[value]);
+    _mediaLibraryFolderFileExplorerViewType = read<int, FileExplorerViewType>(kKeyMediaLibraryFolderFileExplorerViewType, entries, defaults, (value) => FileExplorerViewType.values[value]);
+    _mediaLibraryGenreSortAscending = read<bool, bool>(kKeyMediaLibraryGenreSortAscending, entries, defaults);
+    _mediaLibraryGenreSortType = read<int, GenreSortType>(kKeyMediaLibraryGenreSortType, entries, defaults, (value) => GenreSortType.values[value]);
+    _mediaLibraryHideSecondaryArtists = read<bool, bool>(kKeyMediaLibraryHideSecondaryArtists, entries, defaults);
+    _mediaLibraryMinimumFileSize = read<int, int>(kKeyMediaLibraryMinimumFileSize, entries, defaults);
+    _mediaLibraryPath = read<String, String>(kKeyMediaLibraryPath, entries, defaults);
+    _mediaLibraryRefreshUponStart = read<bool, bool>(kKeyMediaLibraryRefreshUponStart, entries, defaults);
+    _mediaLibraryTrackSortAscending = read<bool, bool>(kKeyMediaLibraryTrackSortAscending, entries, defaults);
+    _mediaLibraryTrackSortType = read<int, TrackSortType>(kKeyMediaLibraryTrackSortType, entries, defaults, (value) => TrackSortType.values[value]);
+    _mediaLibraryTrackViewType = read<int, TrackViewType>(kKeyMediaLibraryTrackViewType, entries, defaults, (value) => TrackViewType.values[value]);
+    _mediaLibraryVisibleTabs = read<dynamic, Set<MediaLibraryTab>>(kKeyMediaLibraryVisibleTabs, entries, defaults, (value) => value.map<MediaLibraryTab>((e) => MediaLibraryTab.values[e]).toSet());
+    _mediaPlayerPlaybackState = read<dynamic, PlaybackState>(kKeyMediaPlayerPlaybackState, entries, defaults, (value) => PlaybackState.fromJson(value));
+    _metaInstallDate = read<String, String>(kKeyMetaInstallDate, entries, defaults);
+    _metaInAppReviewSubmitted = read<bool, bool>(kKeyMetaInAppReviewSubmitted, entries, defaults);
+    _metaLaunchCount = read<int, int>(kKeyMetaLaunchCount, entries, defaults);
+    _mobileMediaLibraryAlbumScrollViewBuilderSpan = read<int, int>(kKeyMobileMediaLibraryAlbumScrollViewBuilderSpan, entries, defaults);
+    _mobileMediaLibraryArtistScrollViewBuilderSpan = read<int, int>(kKeyMobileMediaLibraryArtistScrollViewBuilderSpan, entries, defaults);
+    _mobileMediaLibraryGenreScrollViewBuilderSpan = read<int, int>(kKeyMobileMediaLibraryGenreScrollViewBuilderSpan, entries, defaults);
+    _mobileNotificationLyricsHidden = read<bool, bool>(kKeyMobileNotificationLyricsHidden, entries, defaults);
+    _mobileNowPlayingLyricsFtux = read<int, int>(kKeyMobileNowPlayingLyricsFtux, entries, defaults);
+    _mobileNowPlayingRipple = read<bool, bool>(kKeyMobileNowPlayingRipple, entries, defaults);
+    _mobileNowPlayingVolumeSlider = read<bool, bool>(kKeyMobileNowPlayingVolumeSlider, entries, defaults);
+    _mpvOptions = read<dynamic, Map<String, String>>(kKeyMpvOptions, entries, defaults, (value) => Map<String, String>.from(value));
+    _mpvPath = read<String, String>(kKeyMpvPath, entries, defaults);
+    _notificationLyrics = read<bool, bool>(kKeyNotificationLyrics, entries, defaults);
+    _nowPlayingAudioFormat = read<bool, bool>(kKeyNowPlayingAudioFormat, entries, defaults);
+    _nowPlayingDisplayUponPlay = read<bool, bool>(kKeyNowPlayingDisplayUponPlay, entries, defaults);
+    _nowPlayingStartMixAfterEnding = read<bool, bool>(kKeyNowPlayingStartMixAfterEnding, entries, defaults);
+    _themeAnimationDuration = read<dynamic, AnimationDuration>(kKeyThemeAnimationDuration, entries, defaults, (value) => AnimationDuration.fromJson(value));
+    _themeMaterialStandard = read<int, int>(kKeyThemeMaterialStandard, entries, defaults);
+    _themeMode = read<int, ThemeMode>(kKeyThemeMode, entries, defaults, (value) => ThemeMode.values[value]);
+    _themeSystemColorScheme = read<bool, bool>(kKeyThemeSystemColorScheme, entries, defaults);
+    _updateCheckVersion = read<String, String>(kKeyUpdateCheckVersion, entries, defaults);
+    _windowsTaskbarProgress = read<bool, bool>(kKeyWindowsTaskbarProgress, entries, defaults);
   }
 
   /// Disposes the [instance]. Releases allocated resources back to the system.
@@ -159,20 +168,21 @@ class Configuration extends ConfigurationBase {
     await db.close();
   }
 
-  Future<O> read<I, O>(String key, Map<String, dynamic> defaults, [O Function(I)? map]) async {
+  O read<I, O>(String key, Map<String, Entry> entries, Map<String, dynamic> defaults, [O Function(I)? map]) {
     if (I == O) {
       map ??= (value) => value as O;
     } else if (map == null) {
       throw ArgumentError();
     }
     try {
-      final I i = await switch (I) {
-        const (bool) => db.getBoolean(key),
-        const (int) => db.getInteger(key),
-        const (double) => await db.getDouble(key),
-        const (String) => await db.getString(key),
-        _ => await db.getJson(key),
-      };
+      final entry = entries[key];
+      final I i = switch (I) {
+        const (bool) => entry?.booleanValue,
+        const (int) => entry?.integerValue,
+        const (double) => entry?.doubleValue,
+        const (String) => entry?.stringValue,
+        _ => entry == null ? null : json.decode(entry.jsonValue!),
+      } as I;
       return map(i);
     } catch (exception, stacktrace) {
       debugPrint(exception.toString());
@@ -180,6 +190,9 @@ class Configuration extends ConfigurationBase {
       return defaults[key];
     }
   }
+
+  /// Writes the pending values immediately.
+  Future<void> flush() => db.flush();
 }
 
 /// Returns the default localization.
@@ -145,259 +145,259 @@ class ConfigurationBase {
   }) async {
     if (apiBaseUrl != null) {
       _apiBaseUrl = apiBaseUrl;
-      await db.setValue(kKeyApiBaseUrl, kTypeString, stringValue: apiBaseUrl);
+      db.setValueDeferred(kKeyApiBaseUrl, kTypeString, stringValue: apiBaseUrl);
     }
     if (desktopMediaLibraryFoldersScreenColumnWidths != null) {
       _desktopMediaLibraryFoldersScreenColumnWidths = desktopMediaLibraryFoldersScreenColumnWidths;
-      await db.setValue(kKeyDesktopMediaLibraryFoldersScreenColumnWidths, kTypeJson, jsonValue: desktopMediaLibraryFoldersScreenColumnWidths);
+      db.setValueDeferred(kKeyDesktopMediaLibraryFoldersScreenColumnWidths, kTypeJson, jsonValue: desktopMediaLibraryFoldersScreenColumnWidths);
     }
     if (desktopMediaLibraryTracksScreenColumnWidths != null) {
       _desktopMediaLibraryTracksScreenColumnWidths = desktopMediaLibraryTracksScreenColumnWidths;
-      await db.setValue(kKeyDesktopMediaLibraryTracksScreenColumnWidths, kTypeJson, jsonValue: desktopMediaLibraryTracksScreenColumnWidths);
+      db.setValueDeferred(kKeyDesktopMediaLibraryTracksScreenColumnWidths, kTypeJson, jsonValue: desktopMediaLibraryTracksScreenColumnWidths);
     }
     if (desktopNowPlayingBarColorPalette != null) {
       _desktopNowPlayingBarColorPalette = desktopNowPlayingBarColorPalette;
-      await db.setValue(kKeyDesktopNowPlayingBarColorPalette, kTypeBoolean, booleanValue: desktopNowPlayingBarColorPalette);
+      db.setValueDeferred(kKeyDesktopNowPlayingBarColorPalette, kTypeBoolean, booleanValue: desktopNowPlayingBarColorPalette);
     }
     if (desktopNowPlayingCarousel != null) {
       _desktopNowPlayingCarousel = desktopNowPlayingCarousel;
-      await db.setValue(kKeyDesktopNowPlayingCarousel, kTypeInteger, integerValue: desktopNowPlayingCarousel);
+      db.setValueDeferred(kKeyDesktopNowPlayingCarousel, kTypeInteger, integerValue: desktopNowPlayingCarousel);
     }
     if (desktopNowPlayingLyrics != null) {
       _desktopNowPlayingLyrics = desktopNowPlayingLyrics;
-      await db.setValue(kKeyDesktopNowPlayingLyrics, kTypeBoolean, booleanValue: desktopNowPlayingLyrics);
+      db.setValueDeferred(kKeyDesktopNowPlayingLyrics, kTypeBoolean, booleanValue: desktopNowPlayingLyrics);
     }
     if (discordRpc != null) {
       _discordRpc = discordRpc;
-      await db.setValue(kKeyDiscordRpc, kTypeBoolean, booleanValue: discordRpc);
+      db.setValueDeferred(kKeyDiscordRpc, kTypeBoolean, booleanValue: discordRpc);
     }
     if (identifier != null) {
       _identifier = identifier;
-      await db.setValue(kKeyIdentifier, kTypeString, stringValue: identifier);
+      db.setValueDeferred(kKeyIdentifier, kTypeString, stringValue: identifier);
     }
     if (lastfmSession != null) {
       _lastfmSession = lastfmSession;
-      await db.setValue(kKeyLastfmSession, kTypeJson, jsonValue: lastfmSession.toJson());
+      db.setValueDeferred(kKeyLastfmSession, kTypeJson, jsonValue: lastfmSession.toJson());
     }
     if (localization != null) {
       _localization = localization;
-      await db.setValue(kKeyLocalization, kTypeJson, jsonValue: localization.toJson());
+      db.setValueDeferred(kKeyLocalization, kTypeJson, jsonValue: localization.toJson());
     }
     if (lrcFromDirectory != null) {
       _lrcFromDirectory = lrcFromDirectory;
-      await db.setValue(kKeyLrcFromDirectory, kTypeBoolean, booleanValue: lrcFromDirectory);
+      db.setValueDeferred(kKeyLrcFromDirectory, kTypeBoolean, booleanValue: lrcFromDirectory);
     }
     if (lyricsTranslationLanguage != null) {
       _lyricsTranslationLanguage = lyricsTranslationLanguage;
-      await db.setValue(kKeyLyricsTranslationLanguage, kTypeJson, jsonValue: lyricsTranslationLanguage.toJson());
+      db.setValueDeferred(kKeyLyricsTranslationLanguage, kTypeJson, jsonValue: lyricsTranslationLanguage.toJson());
     }
     if (lyricsViewFocusedFontSize != null) {
       _lyricsViewFocusedFontSize = lyricsViewFocusedFontSize;
-      await db.setValue(kKeyLyricsViewFocusedFontSize, kTypeDouble, doubleValue: lyricsViewFocusedFontSize);
+      db.setValueDeferred(kKeyLyricsViewFocusedFontSize, kTypeDouble, doubleValue: lyricsViewFocusedFontSize);
     }
     if (lyricsViewFocusedLineHeight != null) {
       _lyricsViewFocusedLineHeight = lyricsViewFocusedLineHeight;
-      await db.setValue(kKeyLyricsViewFocusedLineHeight, kTypeDouble, doubleValue: lyricsViewFocusedLineHeight);
+      db.setValueDeferred(kKeyLyricsViewFocusedLineHeight, kTypeDouble, doubleValue: lyricsViewFocusedLineHeight);
     }
     if (lyricsViewFontFamily != null) {
       _lyricsViewFontFamily = lyricsViewFontFamily;
-      await db.setValue(kKeyLyricsViewFontFamily, kTypeString, stringValue: lyricsViewFontFamily);
+      db.setValueDeferred(kKeyLyricsViewFontFamily, kTypeString, stringValue: lyricsViewFontFamily);
     }
     if (lyricsViewTextAlign != null) {
       _lyricsViewTextAlign = lyricsViewTextAlign;
-      await db.setValue(kKeyLyricsViewTextAlign, kTypeInteger, integerValue: lyricsViewTextAlign.index);
+      db.setValueDeferred(kKeyLyricsViewTextAlign, kTypeInteger, integerValue: lyricsViewTextAlign.index);
     }
     if (lyricsViewUnfocusedFontSize != null) {
       _lyricsViewUnfocusedFontSize = lyricsViewUnfocusedFontSize;
-      await db.setValue(kKeyLyricsViewUnfocusedFontSize, kTypeDouble, doubleValue: lyricsViewUnfocusedFontSize);
+      db.setValueDeferred(kKeyLyricsViewUnfocusedFontSize, kTypeDouble, doubleValue: lyricsViewUnfocusedFontSize);
     }
     if (lyricsViewUnfocusedLineHeight != null) {
       _lyricsViewUnfocusedLineHeight = lyricsViewUnfocusedLineHeight;
-      await db.setValue(kKeyLyricsViewUnfocusedLineHeight, kTypeDouble, doubleValue: lyricsViewUnfocusedLineHeight);
+      db.setValueDeferred(kKeyLyricsViewUnfocusedLineHeight, kTypeDouble, doubleValue: lyricsViewUnfocusedLineHeight);
     }
     if (mediaLibraryAddPlaylistToNowPlaying != null) {
       _mediaLibraryAddPlaylistToNowPlaying = mediaLibraryAddPlaylistToNowPlaying;
-      await db.setValue(kKeyMediaLibraryAddPlaylistToNowPlaying, kTypeBoolean, booleanValue: mediaLibraryAddPlaylistToNowPlaying);
+      db.setValueDeferred(kKeyMediaLibraryAddPlaylistToNowPlaying, kTypeBoolean, booleanValue: mediaLibraryAddPlaylistToNowPlaying);
     }
     if (mediaLibraryAlbumGroupingParameters != null) {
       _mediaLibraryAlbumGroupingParameters = mediaLibraryAlbumGroupingParameters;
-      await db.setValue(kKeyMediaLibraryAlbumGroupingParameters, kTypeJson, jsonValue: mediaLibraryAlbumGroupingParameters.toJson());
+      db.setValueDeferred(kKeyMediaLibraryAlbumGroupingParameters, kTypeJson, jsonValue: mediaLibraryAlbumGroupingParameters.toJson());
     }
     if (mediaLibraryAlbumSortAscending != null) {
       _mediaLibraryAlbumSortAscending = mediaLibraryAlbumSortAscending;
-      await db.setValue(kKeyMediaLibraryAlbumSortAscending, kTypeBoolean, booleanValue: mediaLibraryAlbumSortAscending);
+      db.setValueDeferred(kKeyMediaLibraryAlbumSortAscending, kTypeBoolean, booleanValue: mediaLibraryAlbumSortAscending);
     }
     if (mediaLibraryAlbumSortType != null) {
       _mediaLibraryAlbumSortType = mediaLibraryAlbumSortType;
-      await db.setValue(kKeyMediaLibraryAlbumSortType, kTypeInteger, integerValue: mediaLibraryAlbumSortType.index);
+      db.setValueDeferred(kKeyMediaLibraryAlbumSortType, kTypeInteger, integerValue: mediaLibraryAlbumSortType.index);
     }
     if (mediaLibraryArtistImages != null) {
       _mediaLibraryArtistImages = mediaLibraryArtistImages;
-      await db.setValue(kKeyMediaLibraryArtistImages, kTypeBoolean, booleanValue: mediaLibraryArtistImages);
+      db.setValueDeferred(kKeyMediaLibraryArtistImages, kTypeBoolean, booleanValue: mediaLibraryArtistImages);
     }
     if (mediaLibraryArtistSortAscending != null) {
       _mediaLibraryArtistSortAscending = mediaLibraryArtistSortAscending;
-      await db.setValue(kKeyMediaLibraryArtistSortAscending, kTypeBoolean, booleanValue: mediaLibraryArtistSortAscending);
+      db.setValueDeferred(kKeyMediaLibraryArtistSortAscending, kTypeBoolean, booleanValue: mediaLibraryArtistSortAscending);
     }
     if (mediaLibraryArtistSortType != null) {
       _mediaLibraryArtistSortType = mediaLibraryArtistSortType;
-      await db.setValue(kKeyMediaLibraryArtistSortType, kTypeInteger, integerValue: mediaLibraryArtistSortType.index);
+      db.setValueDeferred(kKeyMediaLibraryArtistSortType, kTypeInteger, integerValue: mediaLibraryArtistSortType.index);
     }
     if (mediaLibraryCoverFallback != null) {
       _mediaLibraryCoverFallback = mediaLibraryCoverFallback;
-      await db.setValue(kKeyMediaLibraryCoverFallback, kTypeBoolean, booleanValue: mediaLibraryCoverFallback);
+      db.setValueDeferred(kKeyMediaLibraryCoverFallback, kTypeBoolean, booleanValue: mediaLibraryCoverFallback);
     }
     if (mediaLibraryDirectories != null) {
       _mediaLibraryDirectories = mediaLibraryDirectories;
-      await db.setValue(kKeyMediaLibraryDirectories, kTypeJson, jsonValue: mediaLibraryDirectories.toJson());
+      db.setValueDeferred(kKeyMediaLibraryDirectories, kTypeJson, jsonValue: mediaLibraryDirectories.toJson());
     }
     if (mediaLibraryFolderFileExplorerShowHiddenFiles != null) {
       _mediaLibraryFolderFileExplorerShowHiddenFiles = mediaLibraryFolderFileExplorerShowHiddenFiles;
-      await db.setValue(kKeyMediaLibraryFolderFileExplorerShowHiddenFiles, kTypeBoolean, booleanValue: mediaLibraryFolderFileExplorerShowHiddenFiles);
+      db.setValueDeferred(kKeyMediaLibraryFolderFileExplorerShowHiddenFiles, kTypeBoolean, booleanValue: mediaLibraryFolderFileExplorerShowHiddenFiles);
     }
     if (mediaLibraryFolderFileExplorerSortAscending != null) {
       _mediaLibraryFolderFileExplorerSortAscending = mediaLibraryFolderFileExplorerSortAscending;
-      await db.setValue(kKeyMediaLibraryFolderFileExplorerSortAscending, kTypeBoolean, booleanValue: mediaLibraryFolderFileExplorerSortAscending);
+      db.setValueDeferred(kKeyMediaLibraryFolderFileExplorerSortAscending, kTypeBoolean, booleanValue: mediaLibraryFolderFileExplorerSortAscending);
     }
     if (mediaLibraryFolderFileExplorerSortType != null) {
       _mediaLibraryFolderFileExplorerSortType = mediaLibraryFolderFileExplorerSortType;
-      await db.setValue(kKeyMediaLibraryFolderFileExplorerSortType, kTypeInteger, integerValue: mediaLibraryFolderFileExplorerSortType.index);
+      db.setValueDeferred(kKeyMediaLibraryFolderFileExplorerSortType, kTypeInteger, integerValue: mediaLibraryFolderFileExplorerSortType.index);
     }
     if (mediaLibraryFolderFileExplorerViewType != null) {
       _mediaLibraryFolderFileExplorerViewType = mediaLibraryFolderFileExplorerViewType;
-      await db.setValue(kKeyMediaLibraryFolderFileExplorerViewType, kTypeInteger, integerValue: mediaLibraryFolderFileExplorerViewType.index);
+      db.setValueDeferred(kKeyMediaLibraryFolderFileExplorerViewType, kTypeInteger, integerValue: mediaLibraryFolderFileExplorerViewType.index);
     }
     if (mediaLibraryGenreSortAscending != null) {
       _mediaLibraryGenreSortAscending = mediaLibraryGenreSortAscending;
-      await db.setValue(kKeyMediaLibraryGenreSortAscending, kTypeBoolean, booleanValue: mediaLibraryGenreSortAscending);
+      db.setValueDeferred(kKeyMediaLibraryGenreSortAscending, kTypeBoolean, booleanValue: mediaLibraryGenreSortAscending);
     }
     if (mediaLibraryGenreSortType != null) {
       _mediaLibraryGenreSortType = mediaLibraryGenreSortType;
-      await db.setValue(kKeyMediaLibraryGenreSortType, kTypeInteger, integerValue: mediaLibraryGenreSortType.index);
+      db.setValueDeferred(kKeyMediaLibraryGenreSortType, kTypeInteger, integerValue: mediaLibraryGenreSortType.index);
     }
     if (mediaLibraryHideSecondaryArtists != null) {
       _mediaLibraryHideSecondaryArtists = mediaLibraryHideSecondaryArtists;
-      await db.setValue(kKeyMediaLibraryHideSecondaryArtists, kTypeBoolean, booleanValue: mediaLibraryHideSecondaryArtists);
+      db.setValueDeferred(kKeyMediaLibraryHideSecondaryArtists, kTypeBoolean, booleanValue: mediaLibraryHideSecondaryArtists);
     }
     if (mediaLibraryMinimumFileSize != null) {
       _mediaLibraryMinimumFileSize = mediaLibraryMinimumFileSize;
-      await db.setValue(kKeyMediaLibraryMinimumFileSize, kTypeInteger, integerValue: mediaLibraryMinimumFileSize);
+      db.setValueDeferred(kKeyMediaLibraryMinimumFileSize, kTypeInteger, integerValue: mediaLibraryMinimumFileSize);
     }
     if (mediaLibraryPath != null) {
       _mediaLibraryPath = mediaLibraryPath;
-      await db.setValue(kKeyMediaLibraryPath, kTypeString, stringValue: mediaLibraryPath);
+      db.setValueDeferred(kKeyMediaLibraryPath, kTypeString, stringValue: mediaLibraryPath);
     }
     if (mediaLibraryRefreshUponStart != null) {
       _mediaLibraryRefreshUponStart = mediaLibraryRefreshUponStart;
-      await db.setValue(kKeyMediaLibraryRefreshUponStart, kTypeBoolean, booleanValue: mediaLibraryRefreshUponStart);
+      db.setValueDeferred(kKeyMediaLibraryRefreshUponStart, kTypeBoolean, booleanValue: mediaLibraryRefreshUponStart);
     }
     if (mediaLibraryTrackSortAscending != null) {
       _mediaLibraryTrackSortAscending = mediaLibraryTrackSortAscending;
-      await db.setValue(kKeyMediaLibraryTrackSortAscending, kTypeBoolean, booleanValue: mediaLibraryTrackSortAscending);
+      db.setValueDeferred(kKeyMediaLibraryTrackSortAscending, kTypeBoolean, booleanValue: mediaLibraryTrackSortAscending);
     }
     if (mediaLibraryTrackSortType != null) {
       _mediaLibraryTrackSortType = mediaLibraryTrackSortType;
-      await db.setValue(kKeyMediaLibraryTrackSortType, kTypeInteger, integerValue: mediaLibraryTrackSortType.index);
+      db.setValueDeferred(kKeyMediaLibraryTrackSortType, kTypeInteger, integerValue: mediaLibraryTrackSortType.index);
     }
     if (mediaLibraryTrackViewType != null) {
       _mediaLibraryTrackViewType = mediaLibraryTrackViewType;
-      await db.setValue(kKeyMediaLibraryTrackViewType, kTypeInteger, integerValue: mediaLibraryTrackViewType.index);
+      db.setValueDeferred(kKeyMediaLibraryTrackViewType, kTypeInteger, integerValue: mediaLibraryTrackViewType.index);
     }
     if (mediaLibraryVisibleTabs != null) {
       _mediaLibraryVisibleTabs = mediaLibraryVisibleTabs;
-      await db.setValue(kKeyMediaLibraryVisibleTabs, kTypeJson, jsonValue: mediaLibraryVisibleTabs.toJson());
+      db.setValueDeferred(kKeyMediaLibraryVisibleTabs, kTypeJson, jsonValue: mediaLibraryVisibleTabs.toJson());
     }
     if (mediaPlayerPlaybackState != null) {
       _mediaPlayerPlaybackState = mediaPlayerPlaybackState;
-      await db.setValue(kKeyMediaPlayerPlaybackState, kTypeJson, jsonValue: mediaPlayerPlaybackState.toJson());
+      db.setValueDeferred(kKeyMediaPlayerPlaybackState, kTypeJson, jsonValue: mediaPlayerPlaybackState.toJson());
     }
     if (metaInstallDate != null) {
       _metaInstallDate = metaInstallDate;
-      await db.setValue(kKeyMetaInstallDate, kTypeString, stringValue: metaInstallDate);
+      db.setValueDeferred(kKeyMetaInstallDate, kTypeString, stringValue: metaInstallDate);
     }
     if (metaInAppReviewSubmitted != null) {
       _metaInAppReviewSubmitted = metaInAppReviewSubmitted;
-      await db.setValue(kKeyMetaInAppReviewSubmitted, kTypeBoolean, booleanValue: metaInAppReviewSubmitted);
+      db.setValueDeferred(kKeyMetaInAppReviewSubmitted, kTypeBoolean, booleanValue: metaInAppReviewSubmitted);
     }
     if (metaLaunchCount != null) {
       _metaLaunchCount = metaLaunchCount;
-      await db.setValue(kKeyMetaLaunchCount, kTypeInteger, integerValue: metaLaunchCount);
+      db.setValueDeferred(kKeyMetaLaunchCount, kTypeInteger, integerValue: metaLaunchCount);
     }
     if (mobileMediaLibraryAlbumScrollViewBuilderSpan != null) {
       _mobileMediaLibraryAlbumScrollViewBuilderSpan = mobileMediaLibraryAlbumScrollViewBuilderSpan;
-      await db.setValue(kKeyMobileMediaLibraryAlbumScrollViewBuilderSpan, kTypeInteger, integerValue: mobileMediaLibraryAlbumScrollViewBuilderSpan);
+      db.setValueDeferred(kKeyMobileMediaLibraryAlbumScrollViewBuilderSpan, kTypeInteger, integerValue: mobileMediaLibraryAlbumScrollViewBuilderSpan);
     }
     if (mobileMediaLibraryArtistScrollViewBuilderSpan != null) {
       _mobileMediaLibraryArtistScrollViewBuilderSpan = mobileMediaLibraryArtistScrollViewBuilderSpan;
-      await db.setValue(kKeyMobileMediaLibraryArtistScrollViewBuilderSpan, kTypeInteger, integerValue: mobileMediaLibraryArtistScrollViewBuilderSpan);
+      db.setValueDeferred(kKeyMobileMediaLibraryArtistScrollViewBuilderSpan, kTypeInteger, integerValue: mobileMediaLibraryArtistScrollViewBuilderSpan);
     }
     if (mobileMediaLibraryGenreScrollViewBuilderSpan != null) {
       _mobileMediaLibraryGenreScrollViewBuilderSpan = mobileMediaLibraryGenreScrollViewBuilderSpan;
-      await db.setValue(kKeyMobileMediaLibraryGenreScrollViewBuilderSpan, kTypeInteger, integerValue: mobileMediaLibraryGenreScrollViewBuilderSpan);
+      db.setValueDeferred(kKeyMobileMediaLibraryGenreScrollViewBuilderSpan, kTypeInteger, integerValue: mobileMediaLibraryGenreScrollViewBuilderSpan);
     }
     if (mobileNotificationLyricsHidden != null) {
       _mobileNotificationLyricsHidden = mobileNotificationLyricsHidden;
-      await db.setValue(kKeyMobileNotificationLyricsHidden, kTypeBoolean, booleanValue: mobileNotificationLyricsHidden);
+      db.setValueDeferred(kKeyMobileNotificationLyricsHidden, kTypeBoolean, booleanValue: mobileNotificationLyricsHidden);
     }
     if (mobileNowPlayingLyricsFtux != null) {
       _mobileNowPlayingLyricsFtux = mobileNowPlayingLyricsFtux;
-      await db.setValue(kKeyMobileNowPlayingLyricsFtux, kTypeInteger, integerValue: mobileNowPlayingLyricsFtux);
+      db.setValueDeferred(kKeyMobileNowPlayingLyricsFtux, kTypeInteger, integerValue: mobileNowPlayingLyricsFtux);
     }
     if (mobileNowPlayingRipple != null) {
       _mobileNowPlayingRipple = mobileNowPlayingRipple;
-      await db.setValue(kKeyMobileNowPlayingRipple, kTypeBoolean, booleanValue: mobileNowPlayingRipple);
+      db.setValueDeferred(kKeyMobileNowPlayingRipple, kTypeBoolean, booleanValue: mobileNowPlayingRipple);
     }
     if (mobileNowPlayingVolumeSlider != null) {
       _mobileNowPlayingVolumeSlider = mobileNowPlayingVolumeSlider;
-      await db.setValue(kKeyMobileNowPlayingVolumeSlider, kTypeBoolean, booleanValue: mobileNowPlayingVolumeSlider);
+      db.setValueDeferred(kKeyMobileNowPlayingVolumeSlider, kTypeBoolean, booleanValue: mobileNowPlayingVolumeSlider);
     }
     if (mpvOptions != null) {
       _mpvOptions = mpvOptions;
-      await db.setValue(kKeyMpvOptions, kTypeJson, jsonValue: mpvOptions);
+      db.setValueDeferred(kKeyMpvOptions, kTypeJson, jsonValue: mpvOptions);
     }
     if (mpvPath != null) {
       _mpvPath = mpvPath;
-      await db.setValue(kKeyMpvPath, kTypeString, stringValue: mpvPath);
+      db.setValueDeferred(kKeyMpvPath, kTypeString, stringValue: mpvPath);
     }
     if (notificationLyrics != null) {
       _notificationLyrics = notificationLyrics;
-      await db.setValue(kKeyNotificationLyrics, kTypeBoolean, booleanValue: notificationLyrics);
+      db.setValueDeferred(kKeyNotificationLyrics, kTypeBoolean, booleanValue: notificationLyrics);
     }
     if (nowPlayingAudioFormat != null) {
       _nowPlayingAudioFormat = nowPlayingAudioFormat;
-      await db.setValue(kKeyNowPlayingAudioFormat, kTypeBoolean, booleanValue: nowPlayingAudioFormat);
+      db.setValueDeferred(kKeyNowPlayingAudioFormat, kTypeBoolean, booleanValue: nowPlayingAudioFormat);
     }
     if (nowPlayingDisplayUponPlay != null) {
       _nowPlayingDisplayUponPlay = nowPlayingDisplayUponPlay;
-      await db.setValue(kKeyNowPlayingDisplayUponPlay, kTypeBoolean, booleanValue: nowPlayingDisplayUponPlay);
+      db.setValueDeferred(kKeyNowPlayingDisplayUponPlay, kTypeBoolean, booleanValue: nowPlayingDisplayUponPlay);
     }
     if (nowPlayingStartMixAfterEnding != null) {
       _nowPlayingStartMixAfterEnding = nowPlayingStartMixAfterEnding;
-      await db.setValue(kKeyNowPlayingStartMixAfterEnding, kTypeBoolean, booleanValue: nowPlayingStartMixAfterEnding);
+      db.setValueDeferred(kKeyNowPlayingStartMixAfterEnding, kTypeBoolean, booleanValue: nowPlayingStartMixAfterEnding);
     }
     if (themeAnimationDuration != null) {
       _themeAnimationDuration = themeAnimationDuration;
-      await db.setValue(kKeyThemeAnimationDuration, kTypeJson, jsonValue: themeAnimationDuration.toJson());
+      db.setValueDeferred(kKeyThemeAnimationDuration, kTypeJson, jsonValue: themeAnimationDuration.toJson());
     }
     if (themeMaterialStandard != null) {
       _themeMaterialStandard = themeMaterialStandard;
-      await db.setValue(kKeyThemeMaterialStandard, kTypeInteger, integerValue: themeMaterialStandard);
+      db.setValueDeferred(kKeyThemeMaterialStandard, kTypeInteger, integerValue: themeMaterialStandard);
     }
     if (themeMode != null) {
       _themeMode = themeMode;
-      await db.setValue(kKeyThemeMode, kTypeInteger, integerValue: themeMode.index);
+      db.setValueDeferred(kKeyThemeMode, kTypeInteger, integerValue: themeMode.index);
     }
     if (themeSystemColorScheme != null) {
       _themeSystemColorScheme = themeSystemColorScheme;
-      await db.setValue(kKeyThemeSystemColorScheme, kTypeBoolean, booleanValue: themeSystemColorScheme);
+      db.setValueDeferred(kKeyThemeSystemColorScheme, kTypeBoolean, booleanValue: themeSystemColorScheme);
     }
     if (updateCheckVersion != null) {
       _updateCheckVersion = updateCheckVersion;
-      await db.setValue(kKeyUpdateCheckVersion, kTypeString, stringValue: updateCheckVersion);
+      db.setValueDeferred(kKeyUpdateCheckVersion, kTypeString, stringValue: updateCheckVersion);
     }
     if (windowsTaskbarProgress != null) {
       _windowsTaskbarProgress = windowsTaskbarProgress;
-      await db.setValue(kKeyWindowsTaskbarProgress, kTypeBoolean, booleanValue: windowsTaskbarProgress);
+      db.setValueDeferred(kKeyWindowsTaskbarProgress, kTypeBoolean, booleanValue: windowsTaskbarProgress);
     }
   }
 
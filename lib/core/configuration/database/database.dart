@@ -1,3 +1,4 @@
+import 'dart:async';
 import 'dart:convert';
 import 'dart:io';
 import 'package:drift/drift.dart';
@@ -23,11 +24,14 @@ part 'database.g.dart';
 class Database extends _$Database {
   Database(Directory directory) : super(_openConnection(directory));
 
+  /// Delay after which the values set using [setValueDeferred] are written.
+  static const Duration kWriteDelay = Duration(milliseconds: 500);
+
   @override
   int get schemaVersion => 1;
 
-  /// Sets the value of the entry with the given [key].
-  Future<void> setValue(
+  /// Creates an [Entry] after validating the value(s) against the [type].
+  static Entry createEntry(
     String key,
     int type, {
     bool? booleanValue,
@@ -35,7 +39,7 @@ class Database extends _$Database {
     double? doubleValue,
     String? stringValue,
     dynamic jsonValue,
-  }) async {
+  }) {
     if (type == kTypeBoolean && !(booleanValue != null && integerValue == null && stringValue == null && jsonValue == null)) {
       throw ArgumentError('Invalid type: boolean', 'type');
     }
@@ -52,20 +56,89 @@ class Database extends _$Database {
       throw ArgumentError('Invalid type: json', 'type');
     }
 
+    return Entry(
+      key: key,
+      type: type,
+      booleanValue: booleanValue,
+      integerValue: integerValue,
+      doubleValue: doubleValue,
+      stringValue: stringValue,
+      jsonValue: jsonValue == null ? null : json.encode(jsonValue),
+    );
+  }
+
+  /// Sets the value of the entry with the given [key].
+  Future<void> setValue(
+    String key,
+    int type, {
+    bool? booleanValue,
+    int? integerValue,
+    double? doubleValue,
+    String? stringValue,
+    dynamic jsonValue,
+  }) async {
+    // Prevent a pending (older) value from superseding this one.
+    _pending.remove(key);
     await into(entries).insert(
-      Entry(
-        key: key,
-        type: type,
+      createEntry(
+        key,
+        type,
         booleanValue: booleanValue,
         integerValue: integerValue,
         doubleValue: doubleValue,
         stringValue: stringValue,
-        jsonValue: jsonValue == null ? null : json.encode(jsonValue),
+        jsonValue: jsonValue,
       ),
       mode: InsertMode.replace,
     );
   }
 
+  /// Sets the value of the entry with the given [key] after [kWriteDelay].
+  ///
+  /// Values set in the meantime are written together in a single transaction, a later value for the same [key] supersedes an earlier one.
+  void setValueDeferred(
+    String key,
+    int type, {
+    bool? booleanValue,
+    int? integerValue,
+    double? doubleValue,
+    String? stringValue,
+    dynamic jsonValue,
+  }) {
+    _pending[key] = createEntry(
+      key,
+      type,
+      booleanValue: booleanValue,
+      integerValue: integerValue,
+      doubleValue: doubleValue,
+      stringValue: stringValue,
+      jsonValue: jsonValue,
+    );
+    _timer ??= Timer(kWriteDelay, flush);
+  }
+
+  /// Writes the values set using [setValueDeferred] immediately.
+  Future<void> flush() async {
+    _timer?.cancel();
+    _timer = null;
+    if (_pending.isEmpty) return;
+    final values = _pending.values.toList();
+    _pending.clear();
+    await batch((batch) => batch.insertAll(entries, values, mode: InsertMode.replace));
+  }
+
+  /// Sets the values of the [values] whose keys do not exist, in a single transaction.
+  Future<void> setEntriesIfAbsent(Iterable<Entry> values) async {
+    await batch((batch) => batch.insertAll(entries, values, mode: InsertMode.insertOrIgnore));
+  }
+
+  /// Gets all the entries keyed by their keys, in a single query.
+  Future<Map<String, Entry>> getAll() async {
+    final result = {for (final entry in await select(entries).get()) entry.key: entry};
+    result.addAll(_pending);
+    return result;
+  }
+
   /// Sets the value of the entry with the given [key] if it does not exist.
   Future<void> setValueIfAbsent(
     String key,
@@ -76,31 +149,15 @@ class Database extends _$Database {
     String? stringValue,
     dynamic jsonValue,
   }) async {
-    if (type == kTypeBoolean && !(booleanValue != null && integerValue == null && stringValue == null && jsonValue == null)) {
-      throw ArgumentError('Invalid type: boolean', 'type');
-    }
-    if (type == kTypeInteger && !(booleanValue == null && integerValue != null && stringValue == null && jsonValue == null)) {
-      throw ArgumentError('Invalid type: integer', 'type');
-    }
-    if (type == kTypeDouble && !(booleanValue == null && integerValue == null && stringValue == null && jsonValue == null)) {
-      throw ArgumentError('Invalid type: double', 'type');
-    }
-    if (type == kTypeString && !(booleanValue == null && integerValue == null && stringValue != null && jsonValue == null)) {
-      throw ArgumentError('Invalid type: string', 'type');
-    }
-    if (type == kTypeJson && !(booleanValue == null && integerValue == null && stringValue == null && jsonValue != null)) {
-      throw ArgumentError('Invalid type: json', 'type');
-    }
-
     await into(entries).insert(
-      Entry(
-        key: key,
-        type: type,
+      createEntry(
+        key,
+        type,
         booleanValue: booleanValue,
         integerValue: integerValue,
         doubleValue: doubleValue,
         stringValue: stringValue,
-        jsonValue: jsonValue == null ? null : json.encode(jsonValue),
+        jsonValue: jsonValue,
       ),
       mode: InsertMode.insertOrIgnore,
     );
@@ -108,39 +165,50 @@ class Database extends _$Database {
 
   /// Gets the boolean value of the entry with the given [key].
   Future<bool?> getBoolean(String key) async {
-    final entry = await (select(entries)..where((e) => e.key.equals(key))).getSingleOrNull();
+    final entry = await _getEntry(key);
     return entry?.booleanValue;
   }
 
   /// Gets the integer value of the entry with the given [key].
   Future<int?> getInteger(String key) async {
-    final entry = await (select(entries)..where((e) => e.key.equals(key))).getSingleOrNull();
+    final entry = await _getEntry(key);
     return entry?.integerValue;
   }
 
   /// Gets the double value of the entry with the given [key].
   Future<double?> getDouble(String key) async {
-    final entry = await (select(entries)..where((e) => e.key.equals(key))).getSingleOrNull();
+    final entry = await _getEntry(key);
     return entry?.doubleValue;
   }
 
   /// Gets the string value of the entry with the given [key].
   Future<String?> getString(String key) async {
-    final entry = await (select(entries)..where((e) => e.key.equals(key))).getSingleOrNull();
+    final entry = await _getEntry(key);
     return entry?.stringValue;
   }
 
   /// Gets the JSON value of the entry with the given [key].
   Future<dynamic> getJson(String key) async {
-    final entry = await (select(entries)..where((e) => e.key.equals(key))).getSingleOrNull();
+    final entry = await _getEntry(key);
     return entry == null ? null : json.decode(entry.jsonValue!);
   }
 
   /// Removes the entry with the given [key].
   Future<void> remove(String key) async {
+    _pending.remove(key);
     await (delete(entries)..where((e) => e.key.equals(key))).go();
   }
 
+  @override
+  Future<void> close() async {
+    await flush();
+    await super.close();
+  }
+
+  Future<Entry?> _getEntry(String key) async {
+    return _pending[key] ?? await (select(entries)..where((e) => e.key.equals(key))).getSingleOrNull();
+  }
+
   static LazyDatabase _openConnection(Directory directory) {
     return LazyDatabase(() async {
       final cachebase = (await getTemporaryDirectory()).path;
@@ -150,4 +218,10 @@ class Database extends _$Database {
       return NativeDatabase(file);
     });
   }
+
+  /// Values pending to be written by [flush].
+  final Map<String, Entry> _pending = <String, Entry>{};
+
+  /// [Timer] to invoke [flush].
+  Timer? _timer;
 }
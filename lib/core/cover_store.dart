@@ -0,0 +1,328 @@
+import 'dart:collection';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+import 'package:crypto/crypto.dart';
+import 'package:flutter/foundation.dart';
+import 'package:path/path.dart';
+import 'package:safe_local_storage/safe_local_storage.dart';
+
+import 'package:harmonoid/core/filesystem_media_library.dart';
+import 'package:harmonoid/utils/debouncer.dart';
+
+/// {@template cover_store}
+///
+/// CoverStore
+/// ----------
+/// Implementation to de-duplicate the cover files of the media library by content.
+///
+/// The tag reader extracts a separate cover file for every track, although tracks of the same album usually embed the same image. A
+/// background pass hashes the cover files & keeps a compact index of cover file → content hash. Where symbolic links are available, each
+/// unique image is stored once in [kDirectoryName] & the cover files are replaced with links to it.
+///
+/// [identify] resolves a cover file to its content hash, so that decoded images & thumbnails are shared between all tracks using it.
+///
+/// {@endtemplate}
+class CoverStore {
+  static const String kDirectoryName = 'Store';
+  static const String kIndexFileName = 'Index.BIN';
+  static const int kVersion = 1;
+
+  /// Singleton instance.
+  static final CoverStore instance = CoverStore._();
+
+  /// Whether the [instance] is initialized.
+  static bool initialized = false;
+
+  /// {@macro cover_store}
+  CoverStore._();
+
+  /// Initializes the [instance].
+  static Future<void> ensureInitialized() async {
+    if (initialized) return;
+    initialized = true;
+    instance._covers = FileSystemMediaLibrary.instance.covers;
+    instance._store = Directory(join(instance._covers.path, kDirectoryName));
+    if (!await instance._store.exists_()) {
+      await instance._store.create_();
+    }
+    final path = join(instance._store.path, kIndexFileName);
+    instance._index = await Isolate.run(() => _CoverStoreIndex.read(path));
+    FileSystemMediaLibrary.instance.addListener(instance._listener);
+    instance._listener();
+  }
+
+  /// Returns the content hash of [file], if already known from a previous [identify].
+  String? lookup(File file) => _identities[file.path];
+
+  /// Returns the content hash of [file], or null if [file] is not an indexed cover file.
+  Future<String?> identify(File file) async {
+    if (!initialized || dirname(file.path) != _covers.path) return null;
+    final result = _identities[file.path];
+    if (result != null) return result;
+    final hash = await _resolve(file);
+    if (hash == null) return null;
+    return _identities[file.path] = hash;
+  }
+
+  /// Removes [file] if it is a link into the store. Must be invoked before writing a cover to [file], otherwise the write would follow the
+  /// link & modify the image shared with other tracks.
+  Future<void> detach(File file) async {
+    try {
+      _identities.remove(file.path);
+      if (await FileSystemEntity.isLink(file.path)) {
+        await Link(file.path).delete();
+      }
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+    }
+  }
+
+  /// Evicts the in-memory lookup of [file].
+  void evict(File file) {
+    _identities.remove(file.path);
+  }
+
+  void _listener() {
+    final generation = FileSystemMediaLibrary.instance.generation(MediaLibraryCollection.tracks);
+    if (_generation == generation) return;
+    _generation = generation;
+    // NOTE: Cover files are written throughout a refresh; wait for it to settle.
+    _debouncer.run(_update);
+  }
+
+  Future<void> _update() async {
+    if (_updating) {
+      _dirty = true;
+      return;
+    }
+    _updating = true;
+    _dirty = false;
+    try {
+      _index = await _build(_covers.path, _store.path, _index, !Platform.isWindows);
+      // NOTE: [identify] is not invoked again for images already cached by [AsyncFileImage]; re-identify the known cover files against the
+      //       new index instead of clearing, otherwise they would fall back to per-track keys & lose the de-duplication.
+      for (final path in _identities.keys.toList()) {
+        final hash = await _resolve(File(path));
+        // Evicted or detached in the meantime.
+        if (!_identities.containsKey(path)) continue;
+        if (hash == null) {
+          _identities.remove(path);
+        } else {
+          _identities[path] = hash;
+        }
+      }
+      debugPrint('CoverStore: _update: Covers: ${_index.length}');
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+    } finally {
+      _updating = false;
+      if (_dirty) _update();
+    }
+  }
+
+  Future<String?> _resolve(File file) async {
+    try {
+      final stat = await file.stat();
+      if (stat.type != FileSystemEntityType.file) return null;
+      final hash = _index.lookup(_CoverStoreIndex.hash(basename(file.path)), _CoverStoreIndex.fingerprint(stat));
+      if (hash == null) return null;
+      return _CoverStoreIndex.hex(hash);
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+      return null;
+    }
+  }
+
+  // NOTE: Static, so that the closure sent to the isolate only captures the arguments.
+
+  static Future<_CoverStoreIndex> _build(String covers, String store, _CoverStoreIndex previous, bool link) {
+    return Isolate.run(() {
+      final result = _CoverStoreIndex.build(covers, store, previous, link);
+      try {
+        result.write(join(store, kIndexFileName));
+      } catch (_) {}
+      return result;
+    });
+  }
+
+  /// Directory where the media library stores cover files.
+  late final Directory _covers;
+
+  /// Directory where unique images are stored.
+  late final Directory _store;
+
+  /// Cover file → content hash.
+  _CoverStoreIndex _index = _CoverStoreIndex.empty();
+
+  /// Content hash by cover file path.
+  final HashMap<String, String> _identities = HashMap<String, String>();
+
+  /// [FileSystemMediaLibrary.generation] of the tracks at the last notification.
+  int? _generation;
+
+  bool _updating = false;
+  bool _dirty = false;
+  final Debouncer _debouncer = Debouncer(timeout: const Duration(seconds: 10));
+}
+
+/// Cover file → content hash, sorted by the hash of the file name.
+///
+/// File format (little endian): uint32 version, uint32 count & count entries of int64 file name hash, int64 fingerprint (size & modified
+/// time) & int64 content hash.
+class _CoverStoreIndex {
+  final Int64List names;
+  final Int64List fingerprints;
+  final Int64List hashes;
+
+  const _CoverStoreIndex(this.names, this.fingerprints, this.hashes);
+
+  _CoverStoreIndex.empty() : names = Int64List(0), fingerprints = Int64List(0), hashes = Int64List(0);
+
+  int get length => names.length;
+
+  /// Returns the content hash of the cover file [name] if its [fingerprint] matches.
+  int? lookup(int name, int fingerprint) {
+    var low = 0, high = names.length;
+    while (low < high) {
+      final middle = (low + high) >> 1;
+      if (names[middle] < name) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    if (low < names.length && names[low] == name && fingerprints[low] == fingerprint) {
+      return hashes[low];
+    }
+    return null;
+  }
+
+  /// Indexes the cover files in [covers]; content hashes of unchanged files are re-used from [previous]. If [link] is true, each unique
+  /// image is stored once in [store], cover files are replaced with links to it & images no longer referenced are deleted.
+  static _CoverStoreIndex build(String covers, String store, _CoverStoreIndex previous, bool link) {
+    final entries = <(int, int, int)>[];
+    final referenced = HashSet<String>();
+    for (final entity in Directory(covers).listSync(followLinks: false)) {
+      if (entity.path.endsWith('.tmp')) continue;
+      try {
+        final name = hash(basename(entity.path));
+        if (entity is Link) {
+          final target = entity.targetSync();
+          if (dirname(target) != store) continue;
+          final stat = File(entity.path).statSync();
+          if (stat.type != FileSystemEntityType.file) continue;
+          referenced.add(basename(target));
+          entries.add((name, fingerprint(stat), parse(basename(target))));
+        } else if (entity is File) {
+          var stat = entity.statSync();
+          if (stat.size == 0) continue;
+          final content = previous.lookup(name, fingerprint(stat)) ?? digest(entity);
+          if (link) {
+            final target = File(join(store, hex(content)));
+            if (!target.existsSync()) {
+              entity.copySync('${target.path}.tmp');
+              File('${target.path}.tmp').renameSync(target.path);
+            }
+            // NOTE: The tag reader may re-write the cover file at any time. Instead of checking & then replacing it, the file is moved
+            //       aside (atomic) & the link is created exclusively, so neither a newly created nor a concurrently written file is lost.
+            final aside = File('${entity.path}.old.tmp');
+            entity.renameSync(aside.path);
+            try {
+              Link(entity.path).createSync(target.path);
+            } catch (_) {
+              // Re-created by the tag reader in the meantime.
+              aside.deleteSync();
+              continue;
+            }
+            final current = aside.statSync();
+            if (current.modified != stat.modified || current.size != stat.size) {
+              // Written by the tag reader through an already open handle in the meantime.
+              Link(entity.path).deleteSync();
+              aside.renameSync(entity.path);
+              continue;
+            }
+            aside.deleteSync();
+            referenced.add(basename(target.path));
+            stat = target.statSync();
+          }
+          entries.add((name, fingerprint(stat), content));
+        }
+      } catch (_) {}
+    }
+    if (link) {
+      for (final entity in Directory(store).listSync(followLinks: false)) {
+        final name = basename(entity.path);
+        if (name == CoverStore.kIndexFileName || referenced.contains(name)) continue;
+        try {
+          entity.deleteSync();
+        } catch (_) {}
+      }
+    }
+
+    entries.sort((a, b) => a.$1.compareTo(b.$1));
+    return _CoverStoreIndex(
+      Int64List.fromList([for (final e in entries) e.$1]),
+      Int64List.fromList([for (final e in entries) e.$2]),
+      Int64List.fromList([for (final e in entries) e.$3]),
+    );
+  }
+
+  static _CoverStoreIndex read(String path) {
+    try {
+      final file = File(path);
+      if (!file.existsSync()) return _CoverStoreIndex.empty();
+      final bytes = file.readAsBytesSync();
+      final data = ByteData.sublistView(bytes);
+      if (bytes.length < 8 || data.getUint32(0, Endian.little) != CoverStore.kVersion) return _CoverStoreIndex.empty();
+      final count = data.getUint32(4, Endian.little);
+      if (bytes.length != 8 + 24 * count) return _CoverStoreIndex.empty();
+      final result = _CoverStoreIndex(Int64List(count), Int64List(count), Int64List(count));
+      for (var i = 0; i < count; i++) {
+        result.names[i] = data.getInt64(8 + 24 * i, Endian.little);
+        result.fingerprints[i] = data.getInt64(16 + 24 * i, Endian.little);
+        result.hashes[i] = data.getInt64(24 + 24 * i, Endian.little);
+      }
+      return result;
+    } catch (_) {
+      return _CoverStoreIndex.empty();
+    }
+  }
+
+  void write(String path) {
+    final data = ByteData(8 + 24 * length);
+    data.setUint32(0, CoverStore.kVersion, Endian.little);
+    data.setUint32(4, length, Endian.little);
+    for (var i = 0; i < length; i++) {
+      data.setInt64(8 + 24 * i, names[i], Endian.little);
+      data.setInt64(16 + 24 * i, fingerprints[i], Endian.little);
+      data.setInt64(24 + 24 * i, hashes[i], Endian.little);
+    }
+    final temp = File('$path.tmp');
+    temp.writeAsBytesSync(data.buffer.asUint8List(), flush: true);
+    temp.renameSync(path);
+  }
+
+  /// 64-bit FNV-1a hash of [value].
+  static int hash(String value) {
+    var hash = 0xcbf29ce484222325;
+    for (var i = 0; i < value.length; i++) {
+      hash ^= value.codeUnitAt(i);
+      hash *= 0x100000001b3;
+    }
+    return hash;
+  }
+
+  /// Identifies the contents of a file from its size & modified time.
+  static int fingerprint(FileStat stat) => stat.modified.microsecondsSinceEpoch * 1000003 + stat.size;
+
+  /// First 64 bits of the MD5 of the contents of [file].
+  static int digest(File file) => ByteData.sublistView(Uint8List.fromList(md5.convert(file.readAsBytesSync()).bytes)).getInt64(0);
+
+  static String hex(int value) => [value >> 32, value].map((e) => (e & 0xFFFFFFFF).toRadixString(16).padLeft(8, '0')).join();
+
+  static int parse(String value) => int.parse(value.substring(0, 8), radix: 16) << 32 | int.parse(value.substring(8, 16), radix: 16);
+}
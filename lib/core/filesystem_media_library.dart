@@ -1,4 +1,5 @@
 import 'dart:async';
+import 'dart:collection';
 import 'dart:io';
 import 'package:flutter/foundation.dart';
 import 'package:flutter/services.dart';
@@ -8,8 +9,10 @@ import 'package:path/path.dart';
 import 'package:safe_local_storage/safe_local_storage.dart';
 import 'package:tag_reader/tag_reader.dart' as tag_reader;
 
+import 'package:harmonoid/core/cover_store.dart';
 import 'package:harmonoid/mappers/tags.dart';
 import 'package:harmonoid/utils/android_storage_controller.dart';
+import 'package:harmonoid/utils/string_interner.dart';
 
 /// {@template filesystem_media_library}
 ///
@@ -21,11 +24,14 @@ import 'package:harmonoid/utils/android_storage_controller.dart';
 class FileSystemMediaLibrary extends media_library.FileSystemMediaLibrary with ChangeNotifier {
   static final int kPooledTagReaderSize = () {
     try {
-      return Platform.numberOfProcessors.round().clamp(1, 8) ~/ 2;
+      // Leave one processor for the UI isolate, the tag reader isolates take the rest.
+      return (Platform.numberOfProcessors - 1).clamp(2, 32);
     } catch (_) {
       return 2;
     }
   }();
+  /// Maximum number of memoized [splitTagValue] results.
+  static const int kSplitTagValueCacheSize = 4096;
   static const String kCoverDefaultAssetKey = 'assets/images/default_album.jpg';
   static const String kCoverDefaultFileName = 'Album.JPG';
 
@@ -96,6 +102,7 @@ class FileSystemMediaLibrary extends media_library.FileSystemMediaLibrary with C
       insert: false,
       delete: false,
     );
+    instance._intern();
     if (instance.tracks.isEmpty) {
       // Look for updates from the file-system if the media library is empty.
       // This situation occurs for the first-time application launch.
@@ -125,32 +132,102 @@ class FileSystemMediaLibrary extends media_library.FileSystemMediaLibrary with C
   Future<void> remove(List<Track> tracks, {bool delete = true}) async {
     if (_removeInvoked) return;
     _removeInvoked = true;
+    _dirty = true;
     await super.remove(tracks, delete: delete);
     _removeInvoked = false;
   }
 
+  /// Returns the number of times [collection] has changed.
+  ///
+  /// Listeners interested in a single collection (e.g. with a Selector) can compare this to skip the notifications caused by others.
+  int generation(MediaLibraryCollection collection) => _generations[collection.index];
+
   /// Invoked for notifying about changes in the media library.
   @override
-  Future<void> notify() async => notifyListeners();
+  Future<void> notify() async {
+    _updateGenerations();
+    notifyListeners();
+  }
 
   /// Invoked for performing the parsing operation on the given [file].
   @override
   Future<Track> parse(String uri, File cover, Duration timeout) async {
+    _dirty = true;
+    await CoverStore.instance.detach(cover);
     final tags = await _tagReader.parse(
       uri,
       cover: cover,
       timeout: timeout,
     );
-    final result = tags.toTrack();
-    debugPrint('MediaLibrary: parse: URI: $uri');
-    debugPrint('MediaLibrary: parse: Tags: $tags');
-    debugPrint('MediaLibrary: parse: Result: $result');
+    final result = tags.toTrack(interner: _interner);
+    // NOTE: debugPrint is throttled & these lines would queue up for every file in a full scan.
+    if (kDebugMode) {
+      debugPrint('MediaLibrary: parse: URI: $uri');
+      debugPrint('MediaLibrary: parse: Tags: $tags');
+      debugPrint('MediaLibrary: parse: Result: $result');
+    }
     return result;
   }
 
+  /// Invoked for splitting a tag value (e.g. artists or genres) into separate values.
+  ///
+  /// Values are interned, so tracks share a single copy of each unique value. Up to [kSplitTagValueCacheSize] results are memoized by
+  /// [tag], evicting the least recently used; each invocation returns a new (modifiable) [Set].
   @override
   Set<String> splitTagValue(String? tag) {
-    return tag_reader.splitTagValue(tag);
+    if (tag == null) return tag_reader.splitTagValue(tag);
+    // NOTE: Re-inserted on every hit, so that the first key of the [LinkedHashMap] is the least recently used.
+    var values = _splitTagValueCache.remove(tag);
+    if (values == null) {
+      if (_splitTagValueCache.length >= kSplitTagValueCacheSize) {
+        _splitTagValueCache.remove(_splitTagValueCache.keys.first);
+      }
+      values = _interner.all(tag_reader.splitTagValue(tag)).toList();
+    }
+    _splitTagValueCache[tag] = values;
+    return {...values};
+  }
+
+  /// Interns the repeated values of the tracks loaded from the database.
+  ///
+  /// NOTE: [Track]s loaded from the database are constructed inside the media_library package. The contents of [Track.artists] &
+  ///       [Track.genres] are replaced in place with the interned (equal) values; [Track.album] & [Track.albumArtist] are final.
+  void _intern() {
+    for (final track in tracks) {
+      for (final values in [track.artists, track.genres]) {
+        final interned = _interner.all(values);
+        try {
+          values
+            ..clear()
+            ..addAll(interned);
+        } on UnsupportedError catch (_) {
+          // Unmodifiable, nothing to do.
+          return;
+        }
+      }
+    }
+  }
+
+  /// Increments the [generation] of each [MediaLibraryCollection] whose items changed since the last [notify].
+  ///
+  /// Items change when tracks are parsed ([parse]) or removed ([remove]), which marks every collection; re-sorting & re-grouping is detected
+  /// from the (constant time) state of each collection i.e. length & sort or grouping options.
+  void _updateGenerations() {
+    final dirty = _dirty;
+    // NOTE: Notifications during a refresh may precede the parsed tracks being added; keep marking until it completes.
+    if (!refreshing) _dirty = false;
+    for (final collection in MediaLibraryCollection.values) {
+      final state = switch (collection) {
+        MediaLibraryCollection.albums => (albums.length, albumSortType, albumSortAscending, albumGroupingParameters, hideSecondaryArtists),
+        MediaLibraryCollection.artists => (artists.length, artistSortType, artistSortAscending, hideSecondaryArtists),
+        MediaLibraryCollection.genres => (genres.length, genreSortType, genreSortAscending),
+        MediaLibraryCollection.tracks => (tracks.length, trackSortType, trackSortAscending),
+      };
+      if (dirty || _states[collection.index] != state) {
+        _states[collection.index] = state;
+        _generations[collection.index]++;
+      }
+    }
   }
 
   /// Returns the default cover file.
@@ -170,12 +247,37 @@ class FileSystemMediaLibrary extends media_library.FileSystemMediaLibrary with C
     return Future(() async {
       await super.close();
       await _tagReader.dispose();
+      _splitTagValueCache.clear();
+      _interner.clear();
     });
   }
 
   /// Tag reader.
   final tag_reader.PooledTagReader _tagReader = tag_reader.PooledTagReader(size: kPooledTagReaderSize);
 
+  /// De-duplicates repeated tag values across tracks.
+  final StringInterner _interner = StringInterner();
+
+  /// Memoized [splitTagValue] results by tag value.
+  final LinkedHashMap<String, List<String>> _splitTagValueCache = LinkedHashMap<String, List<String>>();
+
+  /// [generation] of each [MediaLibraryCollection].
+  final List<int> _generations = List<int>.filled(MediaLibraryCollection.values.length, 0);
+
+  /// State (length & sort or grouping options) of each [MediaLibraryCollection] at the last [notify].
+  final List<Object?> _states = List<Object?>.filled(MediaLibraryCollection.values.length, null);
+
+  /// Whether tracks have been parsed or removed since the last [notify]; initially true, for the tracks loaded from the database.
+  bool _dirty = true;
+
   /// Whether [remove] has been invoked.
   bool _removeInvoked = false;
 }
+
+/// Collections of the [FileSystemMediaLibrary], whose changes are tracked separately.
+enum MediaLibraryCollection {
+  albums,
+  artists,
+  genres,
+  tracks,
+}
@@ -0,0 +1,485 @@
+import 'dart:collection';
+import 'dart:math';
+import 'dart:typed_data';
+import 'package:flutter/foundation.dart';
+import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
+
+import 'package:harmonoid/core/filesystem_media_library.dart';
+import 'package:harmonoid/utils/debouncer.dart';
+import 'package:harmonoid/utils/string_interner.dart';
+
+/// {@template media_library_search_index}
+///
+/// MediaLibrarySearchIndex
+/// -----------------------
+/// Implementation of an in-memory inverted index over the albums, artists, genres & tracks of [FileSystemMediaLibrary].
+///
+/// Supports prefix, diacritic-folded & typo-tolerant (single edit) matching. Results are ranked & typed.
+/// The index is updated incrementally i.e. only the inserted & removed items are processed when the media library changes. Listeners are
+/// notified after each update; until then, [ready] is false & results may be missing or partial.
+///
+/// {@endtemplate}
+class MediaLibrarySearchIndex extends ChangeNotifier {
+  /// Minimum length of a token for typo-tolerant matching.
+  static const int kFuzzyMinimumLength = 4;
+
+  /// Number of exact & prefix matches after which typo-tolerant matching is skipped.
+  static const int kFuzzyThreshold = 64;
+
+  /// Number of inserted items after which tokenization is performed on a separate isolate.
+  static const int kComputeThreshold = 1000;
+
+  static const int kScoreExact = 6;
+  static const int kScorePrefix = 4;
+  static const int kScoreFuzzy = 1;
+  static const int kScorePrimaryEqual = 8;
+  static const int kScorePrimaryPrefix = 4;
+
+  /// Singleton instance.
+  static final MediaLibrarySearchIndex instance = MediaLibrarySearchIndex._();
+
+  /// Whether the [instance] is initialized.
+  static bool initialized = false;
+
+  /// {@macro media_library_search_index}
+  MediaLibrarySearchIndex._();
+
+  /// Initializes the [instance].
+  static Future<void> ensureInitialized() async {
+    if (initialized) return;
+    initialized = true;
+    FileSystemMediaLibrary.instance.addListener(instance._listener);
+    instance._update();
+  }
+
+  /// Number of indexed albums, artists, genres & tracks.
+  int get length => _ids.length;
+
+  /// Whether the index is up-to-date with the media library.
+  bool get ready => _ready;
+
+  /// Searches the media library for [query].
+  ///
+  /// [offset] & [limit] are applied separately to each type of result.
+  MediaLibrarySearchResult search(String query, {int offset = 0, int? limit}) {
+    final folded = fold(query).trim();
+    final ids = _cache[folded] ?? _search(folded);
+    _cache
+      ..clear()
+      ..[folded] = ids;
+
+    List<T> page<T>(List<int> ids) {
+      final start = min(offset, ids.length);
+      final end = limit == null ? ids.length : min(start + limit, ids.length);
+      return [for (var i = start; i < end; i++) _items[ids[i]] as T];
+    }
+
+    return MediaLibrarySearchResult(
+      albums: page<Album>(ids.albums),
+      artists: page<Artist>(ids.artists),
+      genres: page<Genre>(ids.genres),
+      tracks: page<Track>(ids.tracks),
+      albumsCount: ids.albums.length,
+      artistsCount: ids.artists.length,
+      genresCount: ids.genres.length,
+      tracksCount: ids.tracks.length,
+    );
+  }
+
+  /// Disposes the [instance]. Releases allocated resources back to the system.
+  @override
+  void dispose() {
+    _debouncer.dispose();
+    FileSystemMediaLibrary.instance.removeListener(_listener);
+    super.dispose();
+  }
+
+  /// Lower-cases [value] & removes diacritics from Latin characters.
+  static String fold(String value) {
+    final buffer = StringBuffer();
+    for (final rune in value.toLowerCase().runes) {
+      if (rune < 0xC0) {
+        buffer.writeCharCode(rune);
+        continue;
+      }
+      final character = String.fromCharCode(rune);
+      final i = _kFoldSource.indexOf(character);
+      if (i >= 0) {
+        buffer.write(_kFoldTarget[i]);
+      } else {
+        buffer.write(_kFoldExpansions[character] ?? character);
+      }
+    }
+    return buffer.toString();
+  }
+
+  /// Splits [value] into folded tokens.
+  static List<String> tokenize(String value) {
+    return fold(value).split(_kSeparator).where((e) => e.isNotEmpty).toList();
+  }
+
+  void _listener() {
+    final generation = MediaLibraryCollection.values.map(FileSystemMediaLibrary.instance.generation).reduce((a, b) => a + b);
+    if (_generation == generation) return;
+    _generation = generation;
+    _ready = false;
+    // NOTE: The media library notifies frequently during a refresh, coalesce those into a single update.
+    _debouncer.run(_update);
+  }
+
+  Future<void> _update() async {
+    if (_updating) {
+      _dirty = true;
+      return;
+    }
+    _updating = true;
+    _dirty = false;
+    try {
+      await _apply();
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+    } finally {
+      _updating = false;
+      if (_dirty) _update();
+    }
+  }
+
+  Future<void> _apply() async {
+    final generation = _generation;
+    final mediaLibrary = FileSystemMediaLibrary.instance;
+    final current = HashSet<Object>()
+      ..addAll(mediaLibrary.albums)
+      ..addAll(mediaLibrary.artists)
+      ..addAll(mediaLibrary.genres)
+      ..addAll(mediaLibrary.tracks);
+
+    final removed = _ids.keys.where((e) => !current.contains(e)).toList();
+    if (removed.length > _ids.length ~/ 2) {
+      // Cheaper to build from scratch.
+      _items.clear();
+      _tokens.clear();
+      _primary.clear();
+      _ids.clear();
+      _postings.clear();
+      _interner.clear();
+    } else {
+      removed.forEach(_remove);
+      if (_items.length > _ids.length * 2) {
+        _compact();
+      }
+    }
+    _cache.clear();
+
+    final added = current.where((e) => !_ids.containsKey(e)).toList();
+    final fields = added.map(_fields).toList();
+    final tokens = fields.length > kComputeThreshold ? await compute(_tokenizeAll, fields) : _tokenizeAll(fields);
+    for (var i = 0; i < added.length; i++) {
+      _insert(added[i], tokens[i].$1, tokens[i].$2);
+    }
+    _cache.clear();
+    // Up-to-date unless the media library changed in the meantime; [_update] runs again in that case.
+    _ready = generation == _generation;
+    notifyListeners();
+
+    debugPrint('MediaLibrarySearchIndex: _update: Items: ${_ids.length}');
+    debugPrint('MediaLibrarySearchIndex: _update: Tokens: ${_postings.length}');
+  }
+
+  /// Returns the primary (e.g. title of a track) & secondary searchable fields of [item].
+  static (String, List<String>) _fields(Object item) {
+    return switch (item) {
+      Album e => (e.album, [e.albumArtist]),
+      Artist e => (e.artist, const <String>[]),
+      Genre e => (e.genre, const <String>[]),
+      Track e => (e.title, [e.album, e.albumArtist, ...e.artists]),
+      _ => throw ArgumentError(),
+    };
+  }
+
+  /// Returns the folded primary field & the tokens of each entry in [fields].
+  static List<(String, List<String>)> _tokenizeAll(List<(String, List<String>)> fields) {
+    return [
+      for (final (primary, secondary) in fields) (fold(primary), {...tokenize(primary), for (final e in secondary) ...tokenize(e)}.toList()),
+    ];
+  }
+
+  void _insert(Object item, String primary, List<String> tokens) {
+    final id = _items.length;
+    // Tokenization runs on another isolate; without interning, every item would retain a separate copy of common tokens.
+    tokens = [for (final token in tokens) _interner(token)];
+    _items.add(item);
+    _tokens.add(tokens);
+    _primary.add(primary);
+    _ids[item] = id;
+    for (final token in tokens) {
+      (_postings[token] ??= <int>[]).add(id);
+    }
+  }
+
+  void _remove(Object item) {
+    final id = _ids.remove(item);
+    if (id == null) return;
+    for (final token in _tokens[id]) {
+      final postings = _postings[token];
+      if (postings == null) continue;
+      // NOTE: Ids are assigned in increasing order, so [postings] is sorted.
+      var low = 0;
+      var high = postings.length;
+      while (low < high) {
+        final middle = (low + high) >> 1;
+        if (postings[middle] < id) {
+          low = middle + 1;
+        } else {
+          high = middle;
+        }
+      }
+      if (low < postings.length && postings[low] == id) {
+        postings.removeAt(low);
+      }
+      if (postings.isEmpty) {
+        _postings.remove(token);
+      }
+    }
+    _items[id] = null;
+    _tokens[id] = const [];
+    _primary[id] = '';
+  }
+
+  /// Re-assigns the ids, dropping the entries left behind by removed items. Tokens are re-used as-is.
+  void _compact() {
+    final items = List.of(_items);
+    final tokens = List.of(_tokens);
+    final primary = List.of(_primary);
+    _items.clear();
+    _tokens.clear();
+    _primary.clear();
+    _ids.clear();
+    _postings.clear();
+    for (var i = 0; i < items.length; i++) {
+      final item = items[i];
+      if (item == null) continue;
+      _insert(item, primary[i], tokens[i]);
+    }
+  }
+
+  _MediaLibrarySearchIndexResult _search(String query) {
+    final tokens = query.split(_kSeparator).where((e) => e.isNotEmpty).toList();
+    if (tokens.isEmpty) return _MediaLibrarySearchIndexResult.empty();
+
+    if (_scores.length < _items.length) {
+      final length = max(_items.length, _scores.length * 2);
+      _scores = Int32List(length);
+      _matches = Int32List(length);
+      _stamps = Int32List(length);
+    }
+
+    // Items matching every token are selected. The first (i.e. best) match of each token decides its score.
+    final hits = <int>[];
+    for (var t = 0; t < tokens.length; t++) {
+      final token = tokens[t];
+      final stamp = ++_stamp;
+      var count = 0;
+
+      void visit(List<int> postings, int score) {
+        for (final id in postings) {
+          if (_stamps[id] == stamp) continue;
+          _stamps[id] = stamp;
+          if (t == 0) {
+            _matches[id] = 1;
+            _scores[id] = score;
+            hits.add(id);
+            count++;
+          } else if (_matches[id] == t) {
+            _matches[id] = t + 1;
+            _scores[id] += score;
+            count++;
+          }
+        }
+      }
+
+      final exact = _postings[token];
+      if (exact != null) {
+        visit(exact, kScoreExact);
+      }
+      for (var key = _postings.firstKeyAfter(token); key != null && key.startsWith(token); key = _postings.firstKeyAfter(key)) {
+        visit(_postings[key]!, kScorePrefix);
+      }
+      if (count < kFuzzyThreshold && token.length >= kFuzzyMinimumLength) {
+        // NOTE: Only tokens sharing the first character are considered, typos at the start are rare & this bounds the scan.
+        final first = token[0];
+        final end = String.fromCharCode(first.codeUnitAt(0) + 1);
+        for (var key = _postings.containsKey(first) ? first : _postings.firstKeyAfter(first); key != null && key.compareTo(end) < 0; key = _postings.firstKeyAfter(key)) {
+          if (key != token && _withinSingleEdit(key, token)) {
+            visit(_postings[key]!, kScoreFuzzy);
+          }
+        }
+      }
+    }
+
+    final result = <int>[];
+    for (final id in hits) {
+      if (_matches[id] == tokens.length) {
+        final primary = _primary[id];
+        if (primary == query) {
+          _scores[id] += kScorePrimaryEqual;
+        } else if (primary.startsWith(query)) {
+          _scores[id] += kScorePrimaryPrefix;
+        }
+        result.add(id);
+      }
+      _matches[id] = 0;
+    }
+    // Ties retain insertion order i.e. media library order.
+    result.sort((a, b) {
+      final compare = _scores[b].compareTo(_scores[a]);
+      return compare != 0 ? compare : a.compareTo(b);
+    });
+
+    final albums = <int>[];
+    final artists = <int>[];
+    final genres = <int>[];
+    final tracks = <int>[];
+    for (final id in result) {
+      switch (_items[id]) {
+        case Album():
+          albums.add(id);
+        case Artist():
+          artists.add(id);
+        case Genre():
+          genres.add(id);
+        case Track():
+          tracks.add(id);
+      }
+    }
+    return _MediaLibrarySearchIndexResult(albums: albums, artists: artists, genres: genres, tracks: tracks);
+  }
+
+  /// Whether [a] & [b] are within a single insertion, deletion or substitution of each other.
+  static bool _withinSingleEdit(String a, String b) {
+    final difference = a.length - b.length;
+    if (difference.abs() > 1) return false;
+    if (difference < 0) return _withinSingleEdit(b, a);
+    var i = 0;
+    while (i < b.length && a.codeUnitAt(i) == b.codeUnitAt(i)) {
+      i++;
+    }
+    if (i == b.length) return true;
+    if (difference == 0) {
+      // Substitution.
+      for (var j = i + 1; j < a.length; j++) {
+        if (a.codeUnitAt(j) != b.codeUnitAt(j)) return false;
+      }
+      return true;
+    }
+    // Deletion.
+    for (var j = i; j < b.length; j++) {
+      if (a.codeUnitAt(j + 1) != b.codeUnitAt(j)) return false;
+    }
+    return true;
+  }
+
+  static final RegExp _kSeparator = RegExp(r'[^\p{L}\p{N}]+', unicode: true);
+
+  static const String _kFoldSource = 'àáâãäåçèéêëìíîïñòóôõöùúûüýÿāăąćĉċčďēĕėęěĝğġģĥĩīĭįĵķĺļľńņňōŏőŕŗřśŝşšţťũūŭůűųŵŷźżžơưǎǐǒǔǖǘǚǜǟǡǧǩǫǭǰǵǹǻȁȃȅȇȉȋȍȏȑȓȕȗșțȟȧȩȫȭȯȱȳøđłħıð';
+  static const String _kFoldTarget = 'aaaaaaceeeeiiiinooooouuuuyyaaaccccdeeeeegggghiiiijklllnnnooorrrssssttuuuuuuwyzzzouaiouuuuuaagkoojgnaaaeeiioorruusthaeooooyodlhid';
+  static const Map<String, String> _kFoldExpansions = {'ß': 'ss', 'æ': 'ae', 'œ': 'oe', 'þ': 'th'};
+
+  /// Sum of [FileSystemMediaLibrary.generation]s at the last notification.
+  int? _generation;
+
+  /// Whether an update is in progress.
+  bool _updating = false;
+
+  /// Whether the index is up-to-date with the media library.
+  bool _ready = false;
+
+  /// Whether the index went out of date with the media library during an update.
+  bool _dirty = false;
+
+  /// Item by id. Removed items leave a null entry behind.
+  final List<Object?> _items = <Object?>[];
+
+  /// Tokens by id.
+  final List<List<String>> _tokens = <List<String>>[];
+
+  /// De-duplicates tokens across items.
+  final StringInterner _interner = StringInterner();
+
+  /// Folded primary text (e.g. title of a track) by id.
+  final List<String> _primary = <String>[];
+
+  /// Id by item.
+  final HashMap<Object, int> _ids = HashMap<Object, int>();
+
+  /// Ids (in increasing order) by token, ordered by token for prefix lookups.
+  final SplayTreeMap<String, List<int>> _postings = SplayTreeMap<String, List<int>>();
+
+  /// Ranked results of the last query; "show all" re-uses these.
+  final Map<String, _MediaLibrarySearchIndexResult> _cache = <String, _MediaLibrarySearchIndexResult>{};
+
+  /// Scratch buffers indexed by id, re-used across queries.
+  Int32List _scores = Int32List(0);
+  Int32List _matches = Int32List(0);
+  Int32List _stamps = Int32List(0);
+  int _stamp = 0;
+
+  /// Debouncer used to coalesce media library notifications.
+  final Debouncer _debouncer = Debouncer(timeout: const Duration(milliseconds: 500));
+}
+
+/// {@template media_library_search_result}
+///
+/// MediaLibrarySearchResult
+/// ------------------------
+/// Ranked results of [MediaLibrarySearchIndex.search].
+///
+/// {@endtemplate}
+class MediaLibrarySearchResult {
+  final List<Album> albums;
+  final List<Artist> artists;
+  final List<Genre> genres;
+  final List<Track> tracks;
+
+  /// Total number of matching albums, regardless of paging.
+  final int albumsCount;
+
+  /// Total number of matching artists, regardless of paging.
+  final int artistsCount;
+
+  /// Total number of matching genres, regardless of paging.
+  final int genresCount;
+
+  /// Total number of matching tracks, regardless of paging.
+  final int tracksCount;
+
+  /// {@macro media_library_search_result}
+  const MediaLibrarySearchResult({
+    required this.albums,
+    required this.artists,
+    required this.genres,
+    required this.tracks,
+    required this.albumsCount,
+    required this.artistsCount,
+    required this.genresCount,
+    required this.tracksCount,
+  });
+
+  bool get isEmpty => albumsCount == 0 && artistsCount == 0 && genresCount == 0 && tracksCount == 0;
+}
+
+class _MediaLibrarySearchIndexResult {
+  final List<int> albums;
+  final List<int> artists;
+  final List<int> genres;
+  final List<int> tracks;
+
+  const _MediaLibrarySearchIndexResult({
+    required this.albums,
+    required this.artists,
+    required this.genres,
+    required this.tracks,
+  });
+
+  factory _MediaLibrarySearchIndexResult.empty() => const _MediaLibrarySearchIndexResult(albums: [], artists: [], genres: [], tracks: []);
+}
@@ -0,0 +1,507 @@
+import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+import 'package:flutter/foundation.dart';
+import 'package:media_library/media_library.dart' hide MediaLibrary;
+import 'package:media_library/media_library.dart' as media_library;
+import 'package:path/path.dart';
+import 'package:pool/pool.dart';
+import 'package:safe_local_storage/safe_local_storage.dart';
+import 'package:synchronized/synchronized.dart';
+
+import 'package:harmonoid/core/bulk_tag_writer.dart';
+import 'package:harmonoid/core/configuration/configuration.dart';
+import 'package:harmonoid/core/filesystem_media_library.dart';
+import 'package:harmonoid/mappers/media_library_item.dart';
+import 'package:harmonoid/utils/async_file_image.dart';
+import 'package:harmonoid/utils/debouncer.dart';
+
+/// {@template media_library_watcher}
+///
+/// MediaLibraryWatcher
+/// -------------------
+/// Implementation to keep the [FileSystemMediaLibrary] in sync with the file-system without walking every directory.
+///
+/// A compact journal of (size, modified) for each file & (modified) for each directory is persisted in the cache.
+/// Since adding, removing or renaming a file changes the modified time of its directory, [reconcile] only lists the directories
+/// whose modified time changed since the journal was written. File-system change notifications (inotify on Linux) mark
+/// directories dirty while the application is running, so in-place modifications are picked up as well. Directories are only watched if
+/// [Configuration.mediaLibraryRefreshUponStart] is enabled; otherwise the media library stays as-is until refreshed manually.
+///
+/// {@endtemplate}
+class MediaLibraryWatcher {
+  static const String kJournalFileName = 'MediaLibraryJournal.BIN';
+  static const Duration kDebounceTimeout = Duration(seconds: 2);
+
+  /// Singleton instance.
+  static final MediaLibraryWatcher instance = MediaLibraryWatcher._();
+
+  /// Whether the [instance] is initialized.
+  static bool initialized = false;
+
+  /// {@macro media_library_watcher}
+  MediaLibraryWatcher._();
+
+  /// Initializes the [instance].
+  static Future<void> ensureInitialized({required Directory cache}) async {
+    if (initialized) return;
+    initialized = true;
+    instance._journal = File(join(cache.path, kJournalFileName));
+  }
+
+  /// Whether the journal exists i.e. [reconcile] is able to compute deltas instead of requiring a full refresh.
+  Future<bool> get available => _journal.exists_();
+
+  /// Applies the changes made to the file-system since the journal was last written.
+  ///
+  /// If [dirty] is null, every journaled directory is checked for a modified time change. Otherwise, only [dirty] directories are listed.
+  /// If the journal does not exist, it is seeded from the current state of the file-system & no deltas are applied.
+  Future<void> reconcile({Set<String>? dirty}) {
+    return _lock.synchronized(() async {
+      final mediaLibrary = FileSystemMediaLibrary.instance;
+      if (mediaLibrary.refreshing) {
+        // NOTE: Retry after the ongoing refresh completes; a full check supersedes the dirty directories.
+        if (dirty == null) {
+          _full = true;
+        } else {
+          _dirty.addAll(dirty);
+        }
+        _pending = true;
+        _debouncer.run(_flush);
+        return;
+      }
+      try {
+        final request = _MediaLibraryWatcherRequest(
+          journal: _journal.path,
+          roots: mediaLibrary.directories.map((e) => normalize(e.path)).toList(),
+          supportedFileTypes: mediaLibrary.supportedFileTypes.toSet(),
+          minimumFileSize: mediaLibrary.minimumFileSize,
+          dirty: dirty?.toList(),
+        );
+        final response = await Isolate.run(() => _reconcile(request));
+
+        debugPrint('MediaLibraryWatcher: reconcile: Listed: ${response.listed}');
+        debugPrint('MediaLibraryWatcher: reconcile: Added: ${response.added.length}');
+        debugPrint('MediaLibraryWatcher: reconcile: Removed: ${response.removed.length}');
+        debugPrint('MediaLibraryWatcher: reconcile: Modified: ${response.modified.length}');
+
+        await _apply(response);
+        await _watch(response.directories);
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    });
+  }
+
+  /// Re-writes the journal from the current state of the file-system, without applying any deltas. Invoke after a full refresh.
+  Future<void> seed() async {
+    await _lock.synchronized(() async {
+      try {
+        await _journal.delete_();
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    });
+    await reconcile();
+  }
+
+  /// Runs [action] without a concurrent [reconcile]. [action] returns the files it modified & already applied to the media library; their
+  /// current state is recorded in the journal, so that the change notifications caused by [action] do not apply the same changes again.
+  Future<void> suspend(Future<List<String>> Function() action) async {
+    if (!initialized) {
+      await action();
+      return;
+    }
+    return _lock.synchronized(() async {
+      final paths = await action();
+      if (paths.isEmpty) return;
+      try {
+        final journal = _journal.path;
+        await Isolate.run(() => _acknowledge(journal, paths));
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    });
+  }
+
+  /// Disposes the [instance]. Releases allocated resources back to the system.
+  Future<void> dispose() async {
+    _debouncer.dispose();
+    await Future.wait(_subscriptions.values.map((e) => e.cancel()));
+    _subscriptions.clear();
+  }
+
+  Future<void> _apply(_MediaLibraryWatcherResponse response) async {
+    if (response.added.isEmpty && response.removed.isEmpty && response.modified.isEmpty) return;
+
+    final mediaLibrary = FileSystemMediaLibrary.instance;
+
+    final tracks = [...response.removed, ...response.modified].map((e) => mediaLibrary.lookupTrack(TrackLookupKey(uri: e))).nonNulls.toList();
+    if (tracks.isNotEmpty) {
+      for (final track in tracks) {
+        AsyncFileImage.reset(track.toImageKey());
+      }
+      await Future.wait(response.modified.map((e) => media_library.MediaLibrary.trackUriToCoverFile(mediaLibrary.covers, e).delete_()));
+      await mediaLibrary.remove(tracks, delete: false);
+    }
+
+    // NOTE: A refresh may have already picked up some of the added files.
+    final added = response.added.where((e) => mediaLibrary.lookupTrack(TrackLookupKey(uri: e)) == null);
+
+    final pool = Pool(FileSystemMediaLibrary.kPooledTagReaderSize);
+    await Future.wait(
+      [...added, ...response.modified].map(
+        (e) => pool.withResource(() async {
+          try {
+            await mediaLibrary.add(File(e));
+          } catch (exception, stacktrace) {
+            debugPrint(exception.toString());
+            debugPrint(stacktrace.toString());
+          }
+        }),
+      ),
+    );
+    await pool.close();
+
+    await mediaLibrary.populate();
+  }
+
+  Future<void> _watch(List<String> directories) async {
+    // NOTE: Recursive watching is not supported on Linux, each directory requires its own inotify watch.
+    final targets = !Configuration.instance.mediaLibraryRefreshUponStart
+        ? <String>{}
+        : Platform.isLinux
+            ? directories.toSet()
+            : FileSystemMediaLibrary.instance.directories.map((e) => normalize(e.path)).toSet();
+
+    for (final path in _subscriptions.keys.where((e) => !targets.contains(e)).toList()) {
+      await _subscriptions.remove(path)?.cancel();
+    }
+    for (final path in targets.where((e) => !_subscriptions.containsKey(e))) {
+      try {
+        _subscriptions[path] = Directory(path).watch(recursive: !Platform.isLinux).listen(
+          _onEvent,
+          onError: (exception) => debugPrint(exception.toString()),
+        );
+      } catch (exception, stacktrace) {
+        // NOTE: Most likely fs.inotify.max_user_watches is exhausted. [reconcile] at startup still catches up with these directories.
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+        break;
+      }
+    }
+  }
+
+  void _onEvent(FileSystemEvent event) {
+    // NOTE: Listing the parent discovers created, deleted & modified entries alike.
+    _dirty.add(normalize(dirname(event.path)));
+    if (event is FileSystemMoveEvent && event.destination != null) {
+      _dirty.add(normalize(dirname(event.destination!)));
+    }
+    _debouncer.run(_flush);
+  }
+
+  void _flush() {
+    if (_dirty.isEmpty && !_pending) return;
+    final dirty = _full ? null : {..._dirty};
+    _dirty.clear();
+    _full = false;
+    _pending = false;
+    reconcile(dirty: dirty);
+  }
+
+  /// Journal file.
+  late final File _journal;
+
+  /// Directories marked dirty by change notifications & pending [reconcile].
+  final Set<String> _dirty = <String>{};
+
+  /// Whether a [reconcile] was deferred by an ongoing refresh.
+  bool _pending = false;
+
+  /// Whether the deferred [reconcile] is a full check.
+  bool _full = false;
+
+  /// Active watch subscriptions keyed by directory path.
+  final Map<String, StreamSubscription<FileSystemEvent>> _subscriptions = <String, StreamSubscription<FileSystemEvent>>{};
+
+  /// Debouncer used to batch change notifications.
+  final Debouncer _debouncer = Debouncer(timeout: kDebounceTimeout);
+
+  /// Lock used to serialize [reconcile] invocations.
+  final Lock _lock = Lock();
+}
+
+// ----------------------------------------------------------------------------------------------------
+
+class _MediaLibraryWatcherRequest {
+  final String journal;
+  final List<String> roots;
+  final Set<String> supportedFileTypes;
+  final int minimumFileSize;
+  final List<String>? dirty;
+
+  const _MediaLibraryWatcherRequest({
+    required this.journal,
+    required this.roots,
+    required this.supportedFileTypes,
+    required this.minimumFileSize,
+    required this.dirty,
+  });
+}
+
+class _MediaLibraryWatcherResponse {
+  final List<String> added;
+  final List<String> removed;
+  final List<String> modified;
+  final List<String> directories;
+  final int listed;
+
+  const _MediaLibraryWatcherResponse({
+    required this.added,
+    required this.removed,
+    required this.modified,
+    required this.directories,
+    required this.listed,
+  });
+}
+
+/// Runs inside a separate isolate. All I/O is synchronous here.
+_MediaLibraryWatcherResponse _reconcile(_MediaLibraryWatcherRequest request) {
+  final journal = _MediaLibraryJournal.read(File(request.journal));
+  final seeding = journal == null;
+  final current = journal ?? _MediaLibraryJournal();
+
+  final added = <String>[];
+  final removed = <String>[];
+  final modified = <String>[];
+  var listed = 0;
+
+  // Directory -> children index, built once per reconcile.
+  final files = <String, Set<String>>{};
+  final directories = <String, Set<String>>{};
+  for (final path in current.files.keys) {
+    files.putIfAbsent(dirname(path), () => <String>{}).add(path);
+  }
+  for (final path in current.directories.keys) {
+    directories.putIfAbsent(dirname(path), () => <String>{}).add(path);
+  }
+
+  void forget(String directory, {required bool report}) {
+    current.directories.remove(directory);
+    for (final path in files.remove(directory) ?? const <String>{}) {
+      current.files.remove(path);
+      if (report) removed.add(path);
+    }
+    for (final path in directories.remove(directory)?.toList() ?? const <String>[]) {
+      forget(path, report: report);
+    }
+  }
+
+  void list(String directory, {required bool report}) {
+    final stat = FileStat.statSync(directory);
+    if (stat.type != FileSystemEntityType.directory) {
+      forget(directory, report: report);
+      return;
+    }
+    listed++;
+    current.directories[directory] = stat.modified.millisecondsSinceEpoch;
+
+    final previousFiles = files[directory] ?? <String>{};
+    final previousDirectories = directories[directory] ?? <String>{};
+    final presentFiles = <String>{};
+    final presentDirectories = <String>{};
+
+    final List<FileSystemEntity> entities;
+    try {
+      entities = Directory(directory).listSync(followLinks: true);
+    } catch (_) {
+      return;
+    }
+    for (final entity in entities) {
+      final path = normalize(entity.path);
+      if (entity is Directory) {
+        presentDirectories.add(path);
+        if (!previousDirectories.contains(path)) {
+          directories.putIfAbsent(directory, () => <String>{}).add(path);
+          list(path, report: report);
+        }
+      } else if (entity is File && request.supportedFileTypes.contains(entity.extension) && !basename(path).startsWith(BulkTagWriter.kTemporaryFilePrefix)) {
+        final stat = entity.statSync();
+        if (stat.size < request.minimumFileSize) continue;
+        presentFiles.add(path);
+        final entry = (stat.size, stat.modified.millisecondsSinceEpoch);
+        final previous = current.files[path];
+        if (previous == null) {
+          if (report) added.add(path);
+        } else if (previous != entry) {
+          if (report) modified.add(path);
+        }
+        current.files[path] = entry;
+        files.putIfAbsent(directory, () => <String>{}).add(path);
+      }
+    }
+    for (final path in previousFiles.difference(presentFiles)) {
+      current.files.remove(path);
+      files[directory]?.remove(path);
+      if (report) removed.add(path);
+    }
+    for (final path in previousDirectories.difference(presentDirectories)) {
+      directories[directory]?.remove(path);
+      forget(path, report: report);
+    }
+  }
+
+  // Roots added or removed since the last reconcile are handled by [FileSystemMediaLibrary.addDirectories] & [FileSystemMediaLibrary.removeDirectories].
+  // Only bring the journal up-to-date for those, without reporting any deltas.
+  final roots = request.roots.toSet();
+  for (final root in current.roots.difference(roots)) {
+    forget(root, report: false);
+  }
+  for (final root in roots.difference(current.roots)) {
+    list(root, report: false);
+  }
+  final journaled = roots.intersection(current.roots);
+  current.roots
+    ..clear()
+    ..addAll(roots);
+
+  if (!seeding) {
+    bool within(String path) => journaled.any((root) => path == root || isWithin(root, path));
+    if (request.dirty == null) {
+      for (final entry in current.directories.entries.toList()) {
+        if (!within(entry.key)) continue;
+        if (!current.directories.containsKey(entry.key)) continue;
+        final stat = FileStat.statSync(entry.key);
+        if (stat.type != FileSystemEntityType.directory) {
+          forget(entry.key, report: true);
+        } else if (stat.modified.millisecondsSinceEpoch != entry.value) {
+          list(entry.key, report: true);
+        }
+      }
+    } else {
+      for (final directory in request.dirty!.where(within)) {
+        list(directory, report: true);
+      }
+    }
+  }
+
+  current.write(File(request.journal));
+
+  return _MediaLibraryWatcherResponse(
+    added: added,
+    removed: removed,
+    modified: modified,
+    directories: current.directories.keys.toList(),
+    listed: listed,
+  );
+}
+
+/// Runs inside a separate isolate. Records the current state of [paths] in the journal at [path].
+///
+/// NOTE: The modified time of the directories is left as-is; listing these once more is cheap & other changes made to them meanwhile
+///       are not missed.
+void _acknowledge(String path, List<String> paths) {
+  final journal = _MediaLibraryJournal.read(File(path));
+  // Without a journal, the next [MediaLibraryWatcher.reconcile] seeds it from the current state anyway.
+  if (journal == null) return;
+  for (final file in paths.map(normalize)) {
+    final stat = FileStat.statSync(file);
+    if (stat.type == FileSystemEntityType.file && journal.files.containsKey(file)) {
+      journal.files[file] = (stat.size, stat.modified.millisecondsSinceEpoch);
+    }
+  }
+  journal.write(File(path));
+}
+
+/// Binary layout (little endian):
+///
+/// ```
+/// uint32 magic, uint32 version
+/// uint32 count, count × (uint16 length, utf8 path)                          -- roots
+/// uint32 count, count × (uint16 length, utf8 path, int64 modified)          -- directories
+/// uint32 count, count × (uint16 length, utf8 path, int64 size, int64 modified) -- files
+/// ```
+class _MediaLibraryJournal {
+  static const int kMagic = 0x4A4C4D48; // HMLJ
+  static const int kVersion = 1;
+
+  final Set<String> roots = <String>{};
+  final Map<String, int> directories = HashMap<String, int>();
+  final Map<String, (int, int)> files = HashMap<String, (int, int)>();
+
+  static _MediaLibraryJournal? read(File file) {
+    try {
+      if (!file.existsSync()) return null;
+      final bytes = file.readAsBytesSync();
+      final data = ByteData.sublistView(bytes);
+      var offset = 0;
+      int uint16() => data.getUint16((offset += 2) - 2, Endian.little);
+      int uint32() => data.getUint32((offset += 4) - 4, Endian.little);
+      int int64() => data.getInt64((offset += 8) - 8, Endian.little);
+      String string() {
+        final length = uint16();
+        return utf8.decode(Uint8List.sublistView(bytes, offset, offset += length));
+      }
+
+      if (uint32() != kMagic || uint32() != kVersion) return null;
+      final result = _MediaLibraryJournal();
+      for (var i = uint32(); i > 0; i--) {
+        result.roots.add(string());
+      }
+      for (var i = uint32(); i > 0; i--) {
+        result.directories[string()] = int64();
+      }
+      for (var i = uint32(); i > 0; i--) {
+        final path = string();
+        result.files[path] = (int64(), int64());
+      }
+      return result;
+    } catch (exception, stacktrace) {
+      // NOTE: A corrupt journal is equivalent to a missing one; it is re-seeded.
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+      return null;
+    }
+  }
+
+  void write(File file) {
+    final builder = BytesBuilder();
+    final scratch = ByteData(8);
+    void uint16(int value) => builder.add(Uint8List.sublistView(scratch..setUint16(0, value, Endian.little), 0, 2));
+    void uint32(int value) => builder.add(Uint8List.sublistView(scratch..setUint32(0, value, Endian.little), 0, 4));
+    void int64(int value) => builder.add(Uint8List.sublistView(scratch..setInt64(0, value, Endian.little), 0, 8));
+    void string(String value) {
+      final bytes = utf8.encode(value);
+      uint16(bytes.length);
+      builder.add(bytes);
+    }
+
+    uint32(kMagic);
+    uint32(kVersion);
+    uint32(roots.length);
+    roots.forEach(string);
+    uint32(directories.length);
+    directories.forEach((path, modified) {
+      string(path);
+      int64(modified);
+    });
+    uint32(files.length);
+    files.forEach((path, entry) {
+      string(path);
+      int64(entry.$1);
+      int64(entry.$2);
+    });
+
+    // NOTE: Write to a temporary file & rename, a partially written journal must never replace a valid one.
+    final temp = File('${file.path}.tmp');
+    temp.writeAsBytesSync(builder.takeBytes(), flush: true);
+    temp.renameSync(file.path);
+  }
+}
@@ -1,25 +1,25 @@
+import 'dart:async';
 import 'dart:io';
 import 'package:audio_session/audio_session.dart';
 import 'package:flutter/foundation.dart';
 import 'package:media_kit/media_kit.dart' hide Playable, Track;
 import 'package:media_kit/generated/libmpv/bindings.dart' show mpv_event_id;
-import 'package:media_library/media_library.dart' hide Playlist, FileSystemMediaLibrary;
-import 'package:safe_local_storage/safe_local_storage.dart';
+import 'package:path/path.dart';
 import 'package:synchronized/synchronized.dart';
-import 'package:tag_reader/tag_reader.dart';
 
 import 'package:harmonoid/core/configuration/configuration.dart';
-import 'package:harmonoid/core/filesystem_media_library.dart';
 import 'package:harmonoid/private/crossfade_player.dart';
 import 'package:harmonoid/core/media_player/mixin/audio_session_mixin.dart';
 import 'package:harmonoid/core/media_player/media_player_mixin_registry.dart';
+import 'package:harmonoid/core/media_player/metadata_resolver.dart';
+import 'package:harmonoid/core/media_player/playable_mapper.dart';
+import 'package:harmonoid/core/media_player/read_ahead_cache.dart';
 import 'package:harmonoid/mappers/loop.dart';
 import 'package:harmonoid/mappers/media.dart';
 import 'package:harmonoid/mappers/playable.dart';
 import 'package:harmonoid/mappers/playback_state.dart';
 import 'package:harmonoid/mappers/playlist_mode.dart';
 import 'package:harmonoid/mappers/replaygain.dart';
-import 'package:harmonoid/mappers/tags.dart';
 import 'package:harmonoid/mappers/track.dart';
 import 'package:harmonoid/core/media_player/models/loop.dart';
 import 'package:harmonoid/core/media_player/models/media_player_state.dart';
@@ -43,6 +43,12 @@ final class MediaPlayer extends ChangeNotifier {
   static const Duration kCrossfadeMaxDuration = Duration(seconds: 30);
   static const int kMixThreshold = 100;
 
+  /// Interval within which the changes to [state] are coalesced into a single notification.
+  static const Duration kDispatchInterval = Duration(milliseconds: 16);
+
+  /// Interval at which the dispatch statistics are printed (in debug mode).
+  static const Duration kStatisticsInterval = Duration(seconds: 60);
+
   /// Singleton instance.
   static final MediaPlayer instance = MediaPlayer._();
 
@@ -71,17 +77,34 @@ final class MediaPlayer extends ChangeNotifier {
     if (_state != state) {
       _state = state;
       notifyListeners();
-
-      updateCurrent();
     }
   }
 
   MediaPlayerMixinRegistry get mixinRegistry => _mixinRegistry;
 
+  /// Schedules the notification of listeners & mixins. Bursts of changes (e.g. [Player] stream events) are coalesced into a single
+  /// notification within [kDispatchInterval].
   @override
   void notifyListeners() {
+    _dispatchEvents++;
+    _dispatchTimer ??= Timer(kDispatchInterval, _dispatch);
+  }
+
+  void _dispatch() {
+    _dispatchTimer = null;
+    _dispatchCount++;
     super.notifyListeners();
     _mixinRegistry.notifyState(state);
+    updateCurrent();
+
+    if (kDebugMode && _dispatchStopwatch.elapsed > kStatisticsInterval) {
+      final seconds = _dispatchStopwatch.elapsed.inMilliseconds / 1000;
+      debugPrint('MediaPlayer: _dispatch: ${(_dispatchCount / seconds).toStringAsFixed(2)} dispatches/s, ${(_dispatchEvents / seconds).toStringAsFixed(2)} events/s');
+      debugPrint(_mixinRegistry.statistics());
+      _dispatchStopwatch.reset();
+      _dispatchCount = 0;
+      _dispatchEvents = 0;
+    }
   }
 
   Future<void> play() => _player.play().then((_) => _mixinRegistry.get<AudioSessionMixin>()?.setActive(true));
@@ -281,6 +304,12 @@ final class MediaPlayer extends ChangeNotifier {
     state = state.copyWith(replayGainPreamp: replayGainPreamp);
   }
 
+  /// Sets the gain (in dB) applied to tracks without ReplayGain tags.
+  Future<void> setReplayGainFallback(double replayGainFallback) async {
+    final platform = _player.platform as dynamic;
+    await platform.setProperty('replaygain-fallback', replayGainFallback.toStringAsFixed(2));
+  }
+
   Future<void> setCrossfadeDuration(
     Duration crossfadeDuration, {
     void Function()? onError = mediaPlayerSetCrossfadeDurationOnError,
@@ -338,7 +367,8 @@ final class MediaPlayer extends ChangeNotifier {
   }
 
   Future<void> mapPlayerToState() async {
-    _player.stream.playlist.listen((e) => _mapPlayerToStatePlaylistLock.synchronized(() => _applyPlayerPlaylistToState(e)));
+    // NOTE: The latest playlist is mapped (instead of the event's), so that events queued behind [_redirect] do not apply its intermediate playlists.
+    _player.stream.playlist.listen((_) => _mapPlayerToStatePlaylistLock.synchronized(() => _applyPlayerPlaylistToState(_player.state.playlist)));
     _player.stream.rate.listen((e) => state = state.copyWith(rate: e));
     _player.stream.pitch.listen((e) => state = state.copyWith(pitch: e));
     _player.stream.volume.listen((e) => state = state.copyWith(volume: e));
@@ -356,38 +386,95 @@ final class MediaPlayer extends ChangeNotifier {
     });
   }
 
-  Future<void> updateCurrent({void Function(String)? onUpdateCurrent = mediaPlayerUpdateCurrentOnUpdateCurrent}) {
-    return _updateCurrentLock.synchronized(() async {
-      try {
-        final uri = state.playables.elementAtOrNull(state.index)?.uri;
+  Future<void> updateCurrent({
+    void Function(String)? onUpdateCurrent = mediaPlayerUpdateCurrentOnUpdateCurrent,
+    void Function(String)? onPrefetch = mediaPlayerUpdateCurrentOnPrefetch,
+  }) async {
+    final uri = state.playables.elementAtOrNull(state.index)?.uri;
 
-        if (uri == null || _updateCurrentFlagUri == uri) return;
-        _updateCurrentFlagUri = uri;
+    if (uri == null || _updateCurrentFlagUri == uri) return;
+    _updateCurrentFlagUri = uri;
 
+    _metadataResolver.prefetch(
+      state.playables.skip(state.index + 1).take(MetadataResolver.kPrefetchCount).map((e) => e.uri),
+      onPrefetch: onPrefetch,
+    );
+    _readAheadCache.prefetch(
+      state.playables.skip(state.index + 1).take(ReadAheadCache.kCount).map((e) => e.uri),
+      // NOTE: Copies which the playlist still points to (e.g. for previous or loop) must not be deleted.
+      retain: [uri, ..._player.state.playlist.medias.where((e) => e.uri != e.playableUri).map((e) => e.playableUri)],
+      onComplete: _redirect,
+    );
+
+    try {
+      // Available immediately if the URI is present in the media library or was prefetched.
+      final result = _metadataResolver.lookup(uri);
+      if (result == null) {
         _current = null;
         notifyListeners();
+      }
 
-        File? cover = MediaLibrary.trackUriToCoverFile(FileSystemMediaLibrary.instance.covers, uri);
-        if (await cover.exists_() && await cover.length_() > 0) {
-          cover = null;
-        }
+      final current = result ?? await _metadataResolver.resolve(uri);
+      // Return prematurely if the current track changed in the meantime.
+      if (_updateCurrentFlagUri != uri) return;
+      _current = current;
+      notifyListeners();
 
-        final tags = await _tagReader.parse(
-          uri,
-          cover: cover,
-          timeout: const Duration(minutes: 1),
-        );
-        _current = tags.toTrack().toPlayable();
-        notifyListeners();
+      onUpdateCurrent?.call(uri);
 
-        onUpdateCurrent?.call(uri);
+      debugPrint('MediaPlayer: updateCurrent: URI: $uri');
+      debugPrint('MediaPlayer: updateCurrent: Current: $current');
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+    }
+  }
 
-        debugPrint('MediaPlayer: updateCurrent: URI: $uri');
-        debugPrint('MediaPlayer: updateCurrent: Tags: $tags');
-        debugPrint('MediaPlayer: updateCurrent: Current: $current');
-      } catch (exception, stacktrace) {
-        debugPrint(exception.toString());
-        debugPrint(stacktrace.toString());
+  /// Replaces the upcoming [Media] of [uri] in the playlist with the local copy at [path].
+  Future<void> _redirect(String uri, String path) {
+    // NOTE: Holding the lock keeps the intermediate playlists (appended, moved) from being mapped to the state; the playlist is mapped
+    //       once afterwards & since the [Playable] is derived from the extras, the state does not change.
+    return _mapPlayerToStatePlaylistLock.synchronized(() async {
+      // Index of the upcoming [Media] of [uri] in the playlist, if any.
+      int upcoming() {
+        final playlist = _player.state.playlist;
+        for (var i = playlist.index + 1; i < playlist.medias.length && i <= playlist.index + ReadAheadCache.kCount; i++) {
+          if (playlist.medias[i].uri == uri) return i;
+        }
+        return -1;
+      }
+
+      // Index of the local copy in the playlist, if any.
+      int copy() => _player.state.playlist.medias.lastIndexWhere((e) => e.uri == path);
+
+      try {
+        final i = upcoming();
+        if (i < 0) return;
+        // NOTE: The copy is inserted right after the original before the original is removed; libmpv may advance at any point & must never
+        //       skip the track. The playlist is re-validated after every step & the copy is removed if anything changed in the meantime,
+        //       so the playlist (& [MediaPlayerState.mixOffset]) either ends up with the original replaced or unchanged.
+        await _player.add(Media(path, extras: _player.state.playlist.medias[i].extras));
+        var from = copy();
+        var to = upcoming();
+        if (from < 0) return;
+        if (to < 0) {
+          await _player.remove(from);
+          return;
+        }
+        if (from != to + 1) {
+          await _player.move(from, to + 1);
+        }
+        from = copy();
+        to = upcoming();
+        if (from < 0) return;
+        if (to < 0 || from != to + 1) {
+          await _player.remove(from);
+          return;
+        }
+        await _player.remove(to);
+        debugPrint('MediaPlayer: _redirect: URI: $uri, Path: $path');
+      } finally {
+        await _applyPlayerPlaylistToState(_player.state.playlist);
       }
     });
   }
@@ -469,11 +556,15 @@ final class MediaPlayer extends ChangeNotifier {
 
   @override
   Future<void> dispose() {
+    _dispatchTimer?.cancel();
+    _dispatchTimer = null;
     super.dispose();
     return Future(() async {
       await _player.dispose();
-      await _tagReader.dispose();
+      await _metadataResolver.dispose();
+      await _readAheadCache.dispose();
       await _mixinRegistry.dispose();
+      _playableMapper.dispose();
     });
   }
 
@@ -503,12 +594,11 @@ final class MediaPlayer extends ChangeNotifier {
     final currentIndex = playlist.index;
     final currentMediaAtIndex = playlist.medias.elementAtOrNull(currentIndex);
 
-    // Avoid heavy deserialization.
-    final shouldUpdatePlayables = !_comparePlayableListAndMediaList(previousPlayables, playlist.medias);
     // Avoid fucking up the lyrics accuracy.
-    final shouldResetPosition = previousPlayableAtIndex?.uri != currentMediaAtIndex?.uri;
+    final shouldResetPosition = previousPlayableAtIndex?.uri != currentMediaAtIndex?.playableUri;
 
-    final currentPlayables = shouldUpdatePlayables ? await compute(_mapMediasToPlayables, playlist.medias) : previousPlayables;
+    // Avoid heavy deserialization; only the changed range is mapped.
+    final currentPlayables = await _playableMapper.map(previousPlayables, playlist.medias);
 
     if (shouldResetPosition) {
       state = state.copyWith(
@@ -524,24 +614,18 @@ final class MediaPlayer extends ChangeNotifier {
     }
   }
 
-  bool _comparePlayableListAndMediaList(List<Playable> playables, List<Media> medias) {
-    if (playables.length != medias.length) return false;
-    for (int i = 0; i < playables.length; i++) {
-      if (playables[i].uri != medias[i].uri) return false;
-    }
-    return true;
-  }
-
   // mapPlayerToState
 
   bool _disablePlayerPlaylistUpdates = false;
   final Lock _mapPlayerToStatePlaylistLock = Lock();
+  final PlayableMapper _playableMapper = PlayableMapper();
 
   // updateCurrent
 
   Playable? _current;
   String? _updateCurrentFlagUri;
-  final Lock _updateCurrentLock = Lock();
+  final MetadataResolver _metadataResolver = MetadataResolver();
+  late final ReadAheadCache _readAheadCache = ReadAheadCache(directory: Directory(join(Configuration.instance.directory.path, ReadAheadCache.kDirectoryName)));
 
   // setMute; muteOrUnmute
 
@@ -551,15 +635,17 @@ final class MediaPlayer extends ChangeNotifier {
 
   final Lock _mixLock = Lock();
 
+  // notifyListeners
+
+  Timer? _dispatchTimer;
+  int _dispatchCount = 0;
+  int _dispatchEvents = 0;
+  final Stopwatch _dispatchStopwatch = Stopwatch()..start();
+
   // -----
 
   MediaPlayerState _state = MediaPlayerState.defaults();
 
   late Player _player;
-  late final TagReader _tagReader = TagReader();
   late final MediaPlayerMixinRegistry _mixinRegistry = MediaPlayerMixinRegistry(this);
 }
-
-List<Playable> _mapMediasToPlayables(List<Media> medias) {
-  return medias.map((e) => e.toPlayable()).toList();
-}
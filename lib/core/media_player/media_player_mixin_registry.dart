@@ -1,3 +1,4 @@
+import 'dart:collection';
 import 'package:flutter/foundation.dart';
 
 import 'package:harmonoid/core/media_player/media_player.dart';
@@ -8,9 +9,13 @@ import 'package:harmonoid/core/media_player/mixin/history_playlist_mixin.dart';
 import 'package:harmonoid/core/media_player/mixin/lastfm_mixin.dart';
 import 'package:harmonoid/core/media_player/mixin/media_player_mixin.dart';
 import 'package:harmonoid/core/media_player/mixin/mpris_mixin.dart';
+import 'package:harmonoid/core/media_player/mixin/playback_queue_journal_mixin.dart';
+import 'package:harmonoid/core/media_player/mixin/replaygain_mixin.dart';
 import 'package:harmonoid/core/media_player/mixin/system_media_transport_controls_mixin.dart';
 import 'package:harmonoid/core/media_player/mixin/windows_taskbar_mixin.dart';
 import 'package:harmonoid/core/media_player/models/media_player_state.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state_field.dart';
+import 'package:harmonoid/core/media_player/models/playable.dart';
 
 /// {@template media_player_mixin_registry}
 ///
@@ -18,9 +23,12 @@ import 'package:harmonoid/core/media_player/models/media_player_state.dart';
 /// ------------------------
 /// Registry for the supported media player mixins.
 ///
+/// Each [MediaPlayerState] is compared against the previously notified one & only the mixins interested in the changed
+/// [MediaPlayerStateField]s are notified. [MediaPlayerState.position] is considered changed once per second.
+///
 /// {@endtemplate}
 final class MediaPlayerMixinRegistry {
-  MediaPlayerMixinRegistry(MediaPlayer player) {
+  MediaPlayerMixinRegistry(MediaPlayer player) : _player = player {
     _mixins.addAll(
       [
         if (AudioServiceMixin.supported) AudioServiceMixin(player),
@@ -29,6 +37,8 @@ final class MediaPlayerMixinRegistry {
         if (HistoryPlaylistMixin.supported) HistoryPlaylistMixin(player),
         if (LastFmMixin.supported) LastFmMixin(player),
         if (MprisMixin.supported) MprisMixin(player),
+        if (PlaybackQueueJournalMixin.supported) PlaybackQueueJournalMixin(player),
+        if (ReplayGainMixin.supported) ReplayGainMixin(player),
         if (SystemMediaTransportControlsMixin.supported) SystemMediaTransportControlsMixin(player),
         if (WindowsTaskbarMixin.supported) WindowsTaskbarMixin(player),
       ],
@@ -44,13 +54,29 @@ final class MediaPlayerMixinRegistry {
   }
 
   Future<void> notifyState(MediaPlayerState state) {
-    return Future.wait(_mixins.map((mixin) => _runCatching(() => mixin.notifyState(state))));
+    final current = state.playables.elementAtOrNull(state.index) == null ? null : _player.current;
+    final fields = _changes(_previousState, state, _previousCurrent, current);
+    _previousState = state;
+    _previousCurrent = current;
+    if (fields.isEmpty) return Future.value();
+    return Future.wait(
+      _mixins.where((mixin) => mixin.interests?.any(fields.contains) ?? true).map((mixin) => _runCatching(() => _measure(mixin, () => mixin.notifyState(state)))),
+    );
   }
 
   Future<void> resetFlags() {
+    _previousState = null;
+    _previousCurrent = null;
     return Future.wait(_mixins.map((mixin) => _runCatching(mixin.resetFlags)));
   }
 
+  /// Returns a summary of the [MediaPlayerMixin.notifyState] invocations & their latencies.
+  String statistics() {
+    return _statistics.entries
+        .map((e) => '${e.key}: ${e.value.count} calls, ${(e.value.total.inMicroseconds / 1000 / e.value.count).toStringAsFixed(2)} ms avg, ${(e.value.max.inMicroseconds / 1000).toStringAsFixed(2)} ms max')
+        .join('\n');
+  }
+
   T? get<T extends MediaPlayerMixin>() {
     for (final mixin in _mixins) {
       if (mixin is T) return mixin;
@@ -67,5 +93,63 @@ final class MediaPlayerMixinRegistry {
     }
   }
 
+  Future<void> _measure(MediaPlayerMixin mixin, Future<void> Function() action) async {
+    final stopwatch = Stopwatch()..start();
+    try {
+      await action();
+    } finally {
+      _statistics.putIfAbsent(mixin.runtimeType, () => _Statistics()).add(stopwatch.elapsed);
+    }
+  }
+
+  static Set<MediaPlayerStateField> _changes(MediaPlayerState? previous, MediaPlayerState state, Playable? previousCurrent, Playable? current) {
+    if (previous == null) return MediaPlayerStateField.values.toSet();
+    return {
+      if (previous.index != state.index) MediaPlayerStateField.index,
+      // NOTE: [PlayableMapper] returns the same instance if the playlist did not change.
+      if (!identical(previous.playables, state.playables)) MediaPlayerStateField.playables,
+      if (previous.rate != state.rate) MediaPlayerStateField.rate,
+      if (previous.pitch != state.pitch) MediaPlayerStateField.pitch,
+      if (previous.volume != state.volume) MediaPlayerStateField.volume,
+      if (previous.shuffle != state.shuffle) MediaPlayerStateField.shuffle,
+      if (previous.loop != state.loop) MediaPlayerStateField.loop,
+      if (previous.exclusiveAudio != state.exclusiveAudio) MediaPlayerStateField.exclusiveAudio,
+      if (previous.replayGain != state.replayGain) MediaPlayerStateField.replayGain,
+      if (previous.replayGainPreamp != state.replayGainPreamp) MediaPlayerStateField.replayGainPreamp,
+      if (previous.crossfadeDuration != state.crossfadeDuration) MediaPlayerStateField.crossfadeDuration,
+      if (previous.position.inSeconds != state.position.inSeconds) MediaPlayerStateField.position,
+      if (previous.duration != state.duration) MediaPlayerStateField.duration,
+      if (previous.playing != state.playing) MediaPlayerStateField.playing,
+      if (previous.buffering != state.buffering) MediaPlayerStateField.buffering,
+      if (previous.completed != state.completed) MediaPlayerStateField.completed,
+      if (previous.audioBitrate != state.audioBitrate) MediaPlayerStateField.audioBitrate,
+      if (previous.audioParams != state.audioParams) MediaPlayerStateField.audioParams,
+      if (previous.mixOffset != state.mixOffset) MediaPlayerStateField.mixOffset,
+      if (!identical(previousCurrent, current)) MediaPlayerStateField.current,
+    };
+  }
+
+  final MediaPlayer _player;
   final List<MediaPlayerMixin> _mixins = [];
+
+  /// Previously notified [MediaPlayerState].
+  MediaPlayerState? _previousState;
+
+  /// Previously notified [MediaPlayer.current].
+  Playable? _previousCurrent;
+
+  /// [MediaPlayerMixin.notifyState] latencies of each [MediaPlayerMixin].
+  final LinkedHashMap<Type, _Statistics> _statistics = LinkedHashMap<Type, _Statistics>();
+}
+
+class _Statistics {
+  int count = 0;
+  Duration total = Duration.zero;
+  Duration max = Duration.zero;
+
+  void add(Duration elapsed) {
+    count++;
+    total += elapsed;
+    if (elapsed > max) max = elapsed;
+  }
 }
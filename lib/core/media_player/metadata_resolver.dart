@@ -0,0 +1,137 @@
+import 'dart:async';
+import 'dart:collection';
+import 'dart:io';
+import 'package:flutter/foundation.dart';
+import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
+import 'package:safe_local_storage/safe_local_storage.dart';
+import 'package:synchronized/synchronized.dart';
+import 'package:tag_reader/tag_reader.dart';
+
+import 'package:harmonoid/core/cover_store.dart';
+import 'package:harmonoid/core/filesystem_media_library.dart';
+import 'package:harmonoid/core/media_player/models/playable.dart';
+import 'package:harmonoid/mappers/tags.dart';
+import 'package:harmonoid/mappers/track.dart';
+
+/// {@template metadata_resolver}
+///
+/// MetadataResolver
+/// ----------------
+/// Implementation to resolve the metadata of URIs as [Playable]s.
+///
+/// URIs present in the media library are resolved from its index, without any I/O. Remaining URIs are parsed & kept in a LRU cache
+/// of [kCapacity] entries. [prefetch] parses upcoming URIs one at a time; only the most recently requested ones are considered, so
+/// skipping through the queue does not pile up parse jobs.
+///
+/// {@endtemplate}
+class MetadataResolver {
+  /// Maximum number of parsed [Playable]s kept in memory.
+  static const int kCapacity = 64;
+
+  /// Number of upcoming URIs to prefetch.
+  static const int kPrefetchCount = 3;
+
+  /// {@macro metadata_resolver}
+  MetadataResolver();
+
+  /// Returns the [Playable] for [uri] if it is available without parsing.
+  Playable? lookup(String uri) {
+    if (FileSystemMediaLibrary.initialized) {
+      final track = FileSystemMediaLibrary.instance.lookupTrack(TrackLookupKey(uri: uri));
+      if (track != null) return track.toPlayable();
+    }
+    final result = _cache.remove(uri);
+    if (result != null) {
+      _cache[uri] = result;
+    }
+    return result;
+  }
+
+  /// Returns the [Playable] for [uri], parsing it if required.
+  Future<Playable> resolve(String uri) {
+    final result = lookup(uri);
+    if (result != null) return Future.value(result);
+    return _pending[uri] ??= _parse(uri).whenComplete(() => _pending.remove(uri));
+  }
+
+  /// Resolves [uris] in the background. Replaces the URIs of previous invocation(s) which have not been resolved yet.
+  ///
+  /// [onPrefetch] is invoked for every URI (e.g. to resolve the cover), after its metadata is resolved.
+  void prefetch(Iterable<String> uris, {void Function(String)? onPrefetch}) {
+    _prefetchQueue
+      ..clear()
+      ..addAll(uris);
+    _onPrefetch = onPrefetch;
+    if (!_prefetchRunning) {
+      _prefetchRunning = true;
+      _prefetch().whenComplete(() => _prefetchRunning = false);
+    }
+  }
+
+  /// Disposes the instance. Releases allocated resources back to the system.
+  Future<void> dispose() async {
+    _prefetchQueue.clear();
+    _cache.clear();
+    await _tagReader.dispose();
+  }
+
+  Future<void> _prefetch() async {
+    while (_prefetchQueue.isNotEmpty) {
+      final uri = _prefetchQueue.removeFirst();
+      try {
+        await resolve(uri);
+        _onPrefetch?.call(uri);
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    }
+  }
+
+  Future<Playable> _parse(String uri) async {
+    File? cover = MediaLibrary.trackUriToCoverFile(FileSystemMediaLibrary.instance.covers, uri);
+    if (await cover.exists_() && await cover.length_() > 0) {
+      cover = null;
+    } else {
+      await CoverStore.instance.detach(cover);
+    }
+
+    // NOTE: [_tagReader] is not pooled; [prefetch] & [resolve] (e.g. of the current URI) must not parse concurrently.
+    final tags = await _parseLock.synchronized(
+      () => _tagReader.parse(
+        uri,
+        cover: cover,
+        timeout: const Duration(minutes: 1),
+      ),
+    );
+    final result = tags.toTrack().toPlayable();
+
+    _cache[uri] = result;
+    while (_cache.length > kCapacity) {
+      _cache.remove(_cache.keys.first);
+    }
+
+    debugPrint('MetadataResolver: _parse: URI: $uri');
+    debugPrint('MetadataResolver: _parse: Tags: $tags');
+
+    return result;
+  }
+
+  /// Parsed [Playable]s; in the order of access.
+  final LinkedHashMap<String, Playable> _cache = LinkedHashMap<String, Playable>();
+
+  /// Ongoing parse operations.
+  final HashMap<String, Future<Playable>> _pending = HashMap<String, Future<Playable>>();
+
+  /// URIs pending to be prefetched.
+  final ListQueue<String> _prefetchQueue = ListQueue<String>();
+
+  /// Whether [_prefetch] is running.
+  bool _prefetchRunning = false;
+
+  /// Callback of the latest [prefetch] invocation.
+  void Function(String)? _onPrefetch;
+
+  late final TagReader _tagReader = TagReader();
+  final Lock _parseLock = Lock();
+}
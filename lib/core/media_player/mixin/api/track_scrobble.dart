@@ -0,0 +1,79 @@
+import 'dart:convert';
+import 'package:crypto/crypto.dart';
+import 'package:http/http.dart' as http;
+import 'package:lastfm/lastfm.dart';
+
+/// {@template track_scrobble}
+///
+/// TrackScrobble
+/// -------------
+/// Last.fm track.scrobble method, submitting up to [kBatchSize] [ScrobbleRequest]s in a single request.
+///
+/// https://www.last.fm/api/show/track.scrobble
+///
+/// {@endtemplate}
+class TrackScrobble {
+  static const int kBatchSize = 50;
+
+  /// Error codes after which the request may be retried as-is.
+  /// 8: Operation failed, 11: Service offline, 16: Temporarily unavailable, 29: Rate limit exceeded.
+  static const Set<int> kRetryableErrors = {8, 11, 16, 29};
+
+  /// Error codes caused by the session; the request may be retried once the session is renewed.
+  /// 4: Authentication failed, 9: Invalid session key, 10: Invalid API key, 14: Unauthorized token, 26: Suspended API key.
+  static const Set<int> kSessionErrors = {4, 9, 10, 14, 26};
+
+  /// {@macro track_scrobble}
+  const TrackScrobble(this.url, this.apiKey, this.sharedSecret);
+
+  final String url;
+  final String apiKey;
+  final String sharedSecret;
+
+  /// Submits [requests]. Returns the number of accepted scrobbles.
+  ///
+  /// Throws [TrackScrobbleException] if Last.fm responded with an error, other exceptions in case of network failure.
+  Future<int> call(String sessionKey, List<ScrobbleRequest> requests) async {
+    assert(requests.length <= kBatchSize);
+    final parameters = <String, String>{
+      'method': 'track.scrobble',
+      'api_key': apiKey,
+      'sk': sessionKey,
+      for (final (i, request) in requests.indexed) ...{
+        'artist[$i]': request.artist,
+        'track[$i]': request.track,
+        'timestamp[$i]': request.timestamp.toString(),
+        if (request.album != null) 'album[$i]': request.album!,
+        if (request.duration != null) 'duration[$i]': request.duration.toString(),
+      },
+    };
+    // https://www.last.fm/api/authspec#_8-signing-calls
+    final keys = parameters.keys.toList()..sort();
+    parameters['api_sig'] = md5.convert(utf8.encode('${keys.map((e) => '$e${parameters[e]}').join()}$sharedSecret')).toString();
+    parameters['format'] = 'json';
+
+    final response = await http.post(Uri.parse(url), body: parameters).timeout(const Duration(seconds: 30));
+    final body = json.decode(utf8.decode(response.bodyBytes));
+    if (body is Map && body['error'] is int) {
+      throw TrackScrobbleException(body['error'], body['message']?.toString() ?? '');
+    }
+    if (response.statusCode != 200) {
+      throw TrackScrobbleException(response.statusCode, response.reasonPhrase ?? '');
+    }
+    return int.tryParse(body['scrobbles']?['@attr']?['accepted']?.toString() ?? '') ?? requests.length;
+  }
+}
+
+class TrackScrobbleException implements Exception {
+  final int code;
+  final String message;
+
+  bool get retryable => TrackScrobble.kRetryableErrors.contains(code) || code >= 500;
+
+  bool get session => TrackScrobble.kSessionErrors.contains(code);
+
+  const TrackScrobbleException(this.code, this.message);
+
+  @override
+  String toString() => 'TrackScrobbleException: $code: $message';
+}
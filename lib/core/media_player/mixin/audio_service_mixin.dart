@@ -7,6 +7,7 @@ import 'package:harmonoid/core/media_player/media_player.dart';
 import 'package:harmonoid/core/media_player/mixin/media_player_mixin.dart';
 import 'package:harmonoid/mappers/image_provider.dart';
 import 'package:harmonoid/core/media_player/models/media_player_state.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state_field.dart';
 import 'package:harmonoid/core/media_player/models/loop.dart';
 import 'package:harmonoid/core/media_player/models/playable.dart';
 import 'package:harmonoid/utils/rendering.dart';
@@ -66,6 +67,19 @@ final class AudioServiceMixin implements MediaPlayerMixin {
     _flagCompleted = null;
   }
 
+  @override
+  Set<MediaPlayerStateField>? get interests => const {
+    MediaPlayerStateField.index,
+    MediaPlayerStateField.current,
+    MediaPlayerStateField.rate,
+    MediaPlayerStateField.shuffle,
+    MediaPlayerStateField.loop,
+    MediaPlayerStateField.position,
+    MediaPlayerStateField.duration,
+    MediaPlayerStateField.playing,
+    MediaPlayerStateField.completed,
+  };
+
   @override
   Future<void> notifyState(MediaPlayerState state) {
     return _lock.synchronized(() async {
@@ -6,6 +6,7 @@ import 'package:flutter/foundation.dart';
 import 'package:harmonoid/core/media_player/media_player.dart';
 import 'package:harmonoid/core/media_player/mixin/media_player_mixin.dart';
 import 'package:harmonoid/core/media_player/models/media_player_state.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state_field.dart';
 
 /// {@template audio_session_mixin}
 ///
@@ -53,6 +54,9 @@ final class AudioSessionMixin implements MediaPlayerMixin {
     // _flagPlaying = null;
   }
 
+  @override
+  Set<MediaPlayerStateField>? get interests => const {};
+
   @override
   Future<void> notifyState(MediaPlayerState state) async {
     // NOTE: Following causes issues on iOS upon index changes.
@@ -16,6 +16,7 @@ import 'package:harmonoid/core/media_player/mixin/media_player_mixin.dart';
 import 'package:harmonoid/extensions/string.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/core/media_player/models/media_player_state.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state_field.dart';
 import 'package:harmonoid/core/media_player/models/playable.dart';
 import 'package:harmonoid/utils/async_file_image.dart';
 import 'package:harmonoid/utils/rendering.dart';
@@ -63,6 +64,14 @@ final class DiscordRpcMixin implements MediaPlayerMixin {
     _largeImage = null;
   }
 
+  @override
+  Set<MediaPlayerStateField>? get interests => const {
+    MediaPlayerStateField.current,
+    MediaPlayerStateField.playing,
+    MediaPlayerStateField.position,
+    MediaPlayerStateField.duration,
+  };
+
   @override
   Future<void> notifyState(MediaPlayerState state) {
     if (_instance?.isConnected != true) return Future.value();
@@ -4,9 +4,12 @@ import 'package:synchronized/synchronized.dart';
 
 import 'package:harmonoid/core/configuration/configuration.dart';
 import 'package:harmonoid/core/media_player/media_player.dart';
+import 'package:harmonoid/core/media_player/mixin/api/track_scrobble.dart';
 import 'package:harmonoid/core/media_player/mixin/media_player_mixin.dart';
+import 'package:harmonoid/core/media_player/scrobble_queue.dart';
 import 'package:harmonoid/mappers/playable.dart';
 import 'package:harmonoid/core/media_player/models/media_player_state.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state_field.dart';
 import 'package:harmonoid/core/media_player/models/playable.dart';
 
 /// {@template Lastfm_mixin}
@@ -20,6 +23,9 @@ final class LastFmMixin implements MediaPlayerMixin {
   static const String kApiKey = String.fromEnvironment('LASTFM_API_KEY');
   static const String kSharedSecret = String.fromEnvironment('LASTFM_SHARED_SECRET');
 
+  /// Endpoint used for submitting scrobbles. May be pointed to scripts/lastfm_mock_server.py for testing.
+  static const String kApiUrl = String.fromEnvironment('LASTFM_API_URL', defaultValue: 'https://ws.audioscrobbler.com/2.0/');
+
   static bool get supported => true;
 
   LastFmMixin(this._player);
@@ -32,6 +38,7 @@ final class LastFmMixin implements MediaPlayerMixin {
       if (connected) {
         _instance.setSession(session);
       }
+      await _scrobbleQueue.ensureInitialized();
     } catch (exception, stacktrace) {
       debugPrint(exception.toString());
       debugPrint(stacktrace.toString());
@@ -40,9 +47,12 @@ final class LastFmMixin implements MediaPlayerMixin {
 
   LastFm get lastFm => _instance;
 
+  ScrobbleQueue get scrobbleQueue => _scrobbleQueue;
+
   @override
   Future<void> dispose() async {
     _instance.clearSession();
+    await _scrobbleQueue.dispose();
   }
 
   @override
@@ -54,6 +64,14 @@ final class LastFmMixin implements MediaPlayerMixin {
     _lastScrobbled = null;
   }
 
+  @override
+  Set<MediaPlayerStateField>? get interests => const {
+    MediaPlayerStateField.current,
+    MediaPlayerStateField.position,
+    MediaPlayerStateField.duration,
+    MediaPlayerStateField.playing,
+  };
+
   @override
   Future<void> notifyState(MediaPlayerState state) {
     // https://www.last.fm/api/scrobbling#when-is-a-scrobble-a-scrobble
@@ -97,12 +115,14 @@ final class LastFmMixin implements MediaPlayerMixin {
 
         final updateNowPlayingRequest = _lastUpdateNowPlaying?.toUpdateNowPlayingRequest(state.duration);
         if (updateNowPlayingRequest != null) {
-          try {
-            await _instance.updateNowPlaying(updateNowPlayingRequest);
-          } catch (exception, stacktrace) {
-            debugPrint(exception.toString());
-            debugPrint(stacktrace.toString());
-          }
+          // NOTE: Not awaited, the network latency must not hold up the subsequent states.
+          _instance.updateNowPlaying(updateNowPlayingRequest).then(
+            (_) {},
+            onError: (exception, stacktrace) {
+              debugPrint(exception.toString());
+              debugPrint(stacktrace.toString());
+            },
+          );
         }
       }
 
@@ -111,12 +131,7 @@ final class LastFmMixin implements MediaPlayerMixin {
 
         final scrobbleRequest = _flagPlayable?.toScrobbleRequest(_lastTimestamp, state.duration);
         if (scrobbleRequest != null) {
-          try {
-            await _instance.scrobble(scrobbleRequest);
-          } catch (exception, stacktrace) {
-            debugPrint(exception.toString());
-            debugPrint(stacktrace.toString());
-          }
+          await _scrobbleQueue.add(scrobbleRequest);
         }
       }
     });
@@ -125,6 +140,11 @@ final class LastFmMixin implements MediaPlayerMixin {
   final MediaPlayer _player;
 
   final LastFm _instance = LastFm(kApiKey, kSharedSecret, kDebugMode);
+  late final ScrobbleQueue _scrobbleQueue = ScrobbleQueue(
+    directory: Configuration.instance.directory,
+    trackScrobble: const TrackScrobble(kApiUrl, kApiKey, kSharedSecret),
+    sessionKey: () => _instance.session?.key,
+  );
   final Lock _lock = Lock();
 
   Playable? _flagPlayable;
@@ -1,4 +1,5 @@
 import 'package:harmonoid/core/media_player/models/media_player_state.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state_field.dart';
 
 /// {@template media_player_mixin}
 ///
@@ -14,5 +15,8 @@ abstract interface class MediaPlayerMixin {
 
   Future<void> notifyState(MediaPlayerState state);
 
+  /// Fields whose changes cause [notifyState] to be invoked. All the fields if null.
+  Set<MediaPlayerStateField>? get interests;
+
   Future<void> resetFlags();
 }
@@ -9,6 +9,7 @@ import 'package:harmonoid/core/media_player/mixin/media_player_mixin.dart';
 import 'package:harmonoid/extensions/media_player_state.dart';
 import 'package:harmonoid/mappers/playable.dart';
 import 'package:harmonoid/core/media_player/models/media_player_state.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state_field.dart';
 import 'package:harmonoid/core/media_player/models/loop.dart';
 import 'package:harmonoid/core/media_player/models/playable.dart';
 
@@ -87,6 +88,21 @@ final class MprisMixin implements MediaPlayerMixin {
     _flagCanGoNext = null;
   }
 
+  @override
+  Set<MediaPlayerStateField>? get interests => const {
+    MediaPlayerStateField.index,
+    MediaPlayerStateField.playables,
+    MediaPlayerStateField.current,
+    MediaPlayerStateField.rate,
+    MediaPlayerStateField.volume,
+    MediaPlayerStateField.shuffle,
+    MediaPlayerStateField.loop,
+    MediaPlayerStateField.position,
+    MediaPlayerStateField.duration,
+    MediaPlayerStateField.playing,
+    MediaPlayerStateField.completed,
+  };
+
   @override
   Future<void> notifyState(MediaPlayerState state) {
     return _lock.synchronized(() async {
@@ -0,0 +1,48 @@
+import 'package:harmonoid/core/media_player/media_player.dart';
+import 'package:harmonoid/core/media_player/mixin/media_player_mixin.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state_field.dart';
+import 'package:harmonoid/core/media_player/playback_queue_journal.dart';
+
+/// {@template playback_queue_journal_mixin}
+///
+/// PlaybackQueueJournalMixin
+/// -------------------------
+/// Records the changes to the queue of [MediaPlayer] in [PlaybackQueueJournal].
+///
+/// {@endtemplate}
+final class PlaybackQueueJournalMixin implements MediaPlayerMixin {
+  static bool get supported => true;
+
+  PlaybackQueueJournalMixin(this._player);
+
+  @override
+  Future<void> ensureInitialized() async {
+    // NO/OP
+  }
+
+  @override
+  Future<void> dispose() async {
+    await PlaybackQueueJournal.instance.dispose();
+  }
+
+  @override
+  Future<void> resetFlags() async {
+    // NO/OP
+  }
+
+  @override
+  Set<MediaPlayerStateField>? get interests => const {
+    MediaPlayerStateField.index,
+    MediaPlayerStateField.playables,
+  };
+
+  @override
+  Future<void> notifyState(MediaPlayerState state) async {
+    if (!PlaybackQueueJournal.initialized) return;
+    await PlaybackQueueJournal.instance.update(state.playables, state.index);
+  }
+
+  // ignore: unused_field
+  final MediaPlayer _player;
+}
@@ -0,0 +1,87 @@
+import 'dart:async';
+import 'dart:io';
+import 'package:synchronized/synchronized.dart';
+
+import 'package:harmonoid/core/audio_analyzer.dart';
+import 'package:harmonoid/core/media_player/media_player.dart';
+import 'package:harmonoid/core/media_player/mixin/media_player_mixin.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state_field.dart';
+import 'package:harmonoid/core/media_player/models/replaygain.dart';
+
+/// {@template replaygain_mixin}
+///
+/// ReplayGainMixin
+/// ---------------
+/// Applies the loudness measured by [AudioAnalyzer] to tracks without ReplayGain tags in [MediaPlayer].
+///
+/// The whole media library is only analyzed in background on desktop while ReplayGain is enabled. Otherwise, the current & next tracks
+/// are analyzed as these are played.
+///
+/// {@endtemplate}
+final class ReplayGainMixin implements MediaPlayerMixin {
+  static bool get supported => true;
+
+  ReplayGainMixin(this._player);
+
+  @override
+  Future<void> ensureInitialized() async {
+    // NO/OP
+  }
+
+  @override
+  Future<void> dispose() async {
+    AudioAnalyzer.instance.dispose();
+  }
+
+  @override
+  Future<void> resetFlags() async {
+    _flagUri = null;
+    _flagReplayGain = null;
+    _flagReplayGainPreamp = null;
+  }
+
+  @override
+  Set<MediaPlayerStateField>? get interests => const {
+    MediaPlayerStateField.index,
+    MediaPlayerStateField.playables,
+    MediaPlayerStateField.replayGain,
+    MediaPlayerStateField.replayGainPreamp,
+  };
+
+  @override
+  Future<void> notifyState(MediaPlayerState state) {
+    return _lock.synchronized(() async {
+      if (!AudioAnalyzer.initialized) return;
+
+      final uri = state.playables.elementAtOrNull(state.index)?.uri;
+      if (_flagUri == uri && _flagReplayGain == state.replayGain && _flagReplayGainPreamp == state.replayGainPreamp) return;
+
+      if (_flagReplayGain != state.replayGain) {
+        if (state.replayGain == ReplayGain.off) {
+          AudioAnalyzer.instance.stop();
+        } else if (!Platform.isAndroid && !Platform.isIOS) {
+          unawaited(AudioAnalyzer.instance.start());
+        }
+      }
+      if (_flagUri != uri && state.replayGain != ReplayGain.off) {
+        AudioAnalyzer.instance.enqueue([state.index, state.index + 1].map((e) => state.playables.elementAtOrNull(e)?.uri).nonNulls);
+      }
+
+      _flagUri = uri;
+      _flagReplayGain = state.replayGain;
+      _flagReplayGainPreamp = state.replayGainPreamp;
+
+      // NOTE: replaygain-fallback is also applied when ReplayGain is off, hence 0.0 dB in that case.
+      final gain = uri == null ? null : AudioAnalyzer.instance.gain(uri, state.replayGain, preamp: state.replayGainPreamp);
+      await _player.setReplayGainFallback(gain ?? 0.0);
+    });
+  }
+
+  final MediaPlayer _player;
+  final Lock _lock = Lock();
+
+  String? _flagUri;
+  ReplayGain? _flagReplayGain;
+  double? _flagReplayGainPreamp;
+}
@@ -4,6 +4,7 @@ import 'package:synchronized/synchronized.dart';
 import 'package:harmonoid/core/media_player/media_player.dart';
 import 'package:harmonoid/core/media_player/mixin/media_player_mixin.dart';
 import 'package:harmonoid/core/media_player/models/media_player_state.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state_field.dart';
 import 'package:harmonoid/core/media_player/models/playable.dart';
 
 /// {@template stub_mixin}
@@ -35,6 +36,9 @@ final class StubMixin implements MediaPlayerMixin {
     _flagPlayable = null;
   }
 
+  @override
+  Set<MediaPlayerStateField>? get interests => null;
+
   @override
   Future<void> notifyState(MediaPlayerState state) {
     return _lock.synchronized(() async {
@@ -5,6 +5,7 @@ import 'package:harmonoid/core/media_player/media_player.dart';
 import 'package:harmonoid/core/media_player/mixin/media_player_mixin.dart';
 import 'package:harmonoid/mappers/image_provider.dart';
 import 'package:harmonoid/core/media_player/models/media_player_state.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state_field.dart';
 import 'package:harmonoid/core/media_player/models/playable.dart';
 import 'package:harmonoid/utils/rendering.dart';
 import 'package:synchronized/synchronized.dart';
@@ -61,6 +62,14 @@ final class SystemMediaTransportControlsMixin implements MediaPlayerMixin {
     _flagPosition = null;
   }
 
+  @override
+  Set<MediaPlayerStateField>? get interests => const {
+    MediaPlayerStateField.current,
+    MediaPlayerStateField.position,
+    MediaPlayerStateField.duration,
+    MediaPlayerStateField.playing,
+  };
+
   @override
   Future<void> notifyState(MediaPlayerState state) {
     return _lock.synchronized(() async {
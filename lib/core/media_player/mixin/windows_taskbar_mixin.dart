@@ -7,6 +7,7 @@ import 'package:harmonoid/core/media_player/mixin/media_player_mixin.dart';
 import 'package:harmonoid/extensions/media_player_state.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/core/media_player/models/media_player_state.dart';
+import 'package:harmonoid/core/media_player/models/media_player_state_field.dart';
 import 'package:windows_taskbar/windows_taskbar.dart';
 
 /// {@template windows_taskbar_mixin}
@@ -36,6 +37,16 @@ final class WindowsTaskbarMixin implements MediaPlayerMixin {
     _flagPlaying = null;
   }
 
+  @override
+  Set<MediaPlayerStateField>? get interests => const {
+    MediaPlayerStateField.index,
+    MediaPlayerStateField.playables,
+    MediaPlayerStateField.loop,
+    MediaPlayerStateField.position,
+    MediaPlayerStateField.duration,
+    MediaPlayerStateField.playing,
+  };
+
   @override
   Future<void> notifyState(MediaPlayerState state) {
     return _lock.synchronized(() async {
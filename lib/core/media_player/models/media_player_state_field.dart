@@ -0,0 +1,25 @@
+/// Fields of [MediaPlayerState] which [MediaPlayerMixin]s may be interested in.
+///
+/// [current] refers to [MediaPlayer.current], which is updated after the tags of the current track are read.
+enum MediaPlayerStateField {
+  index,
+  playables,
+  rate,
+  pitch,
+  volume,
+  shuffle,
+  loop,
+  exclusiveAudio,
+  replayGain,
+  replayGainPreamp,
+  crossfadeDuration,
+  position,
+  duration,
+  playing,
+  buffering,
+  completed,
+  audioBitrate,
+  audioParams,
+  mixOffset,
+  current,
+}
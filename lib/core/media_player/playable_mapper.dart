@@ -0,0 +1,151 @@
+import 'dart:async';
+import 'dart:collection';
+import 'dart:isolate';
+import 'package:flutter/foundation.dart';
+import 'package:media_kit/media_kit.dart' hide Playable;
+
+import 'package:harmonoid/core/media_player/models/playable.dart';
+import 'package:harmonoid/mappers/media.dart';
+
+/// {@template playable_mapper}
+///
+/// PlayableMapper
+/// --------------
+/// Implementation to map [Media]s in the [Player]'s playlist to [Playable]s, re-using the previously mapped [Playable]s.
+///
+/// Only the range between the common prefix & suffix of the previous & current playlists is considered. Within that range, [Playable]s
+/// are re-used by URI (which covers move operations & redirects), the remaining [Media]s are deserialized; on a persistent worker isolate if many.
+///
+/// {@endtemplate}
+class PlayableMapper {
+  /// Number of [Media]s after which deserialization is performed on the worker isolate.
+  static const int kWorkerThreshold = 256;
+
+  /// {@macro playable_mapper}
+  PlayableMapper();
+
+  /// Returns [Playable]s corresponding to [medias], re-using [previous] wherever possible.
+  ///
+  /// Returns [previous] itself if nothing changed.
+  Future<List<Playable>> map(List<Playable> previous, List<Media> medias) async {
+    final n = previous.length;
+    final m = medias.length;
+
+    var prefix = 0;
+    while (prefix < n && prefix < m && previous[prefix].uri == medias[prefix].playableUri) {
+      prefix++;
+    }
+    if (prefix == n && prefix == m) return previous;
+
+    var suffix = 0;
+    while (suffix < n - prefix && suffix < m - prefix && previous[n - 1 - suffix].uri == medias[m - 1 - suffix].playableUri) {
+      suffix++;
+    }
+
+    // NOTE: Duplicate URIs are allowed in the playlist, hence a queue of candidates per URI.
+    final candidates = HashMap<String, ListQueue<Playable>>();
+    for (var i = prefix; i < n - suffix; i++) {
+      candidates.putIfAbsent(previous[i].uri, () => ListQueue<Playable>()).add(previous[i]);
+    }
+
+    final middle = List<Playable?>.filled(m - prefix - suffix, null);
+    final missing = <int>[];
+    for (var i = 0; i < middle.length; i++) {
+      final queue = candidates[medias[prefix + i].playableUri];
+      if (queue == null || queue.isEmpty) {
+        missing.add(i);
+      } else {
+        middle[i] = queue.removeFirst();
+      }
+    }
+
+    if (missing.isNotEmpty) {
+      final extras = [for (final i in missing) medias[prefix + i].extras];
+      final playables = extras.length > kWorkerThreshold ? await _worker(extras) : [for (final i in missing) medias[prefix + i].toPlayable()];
+      for (var i = 0; i < missing.length; i++) {
+        middle[missing[i]] = playables[i];
+      }
+    }
+
+    return [
+      ...previous.take(prefix),
+      ...middle.cast<Playable>(),
+      ...previous.skip(n - suffix),
+    ];
+  }
+
+  /// Disposes the instance. Releases allocated resources back to the system.
+  void dispose() {
+    _isolate?.kill(priority: Isolate.immediate);
+    _reset(StateError('PlayableMapper has been disposed.'));
+  }
+
+  Future<List<Playable>> _worker(List<Map<String, dynamic>?> extras) async {
+    final sendPort = await (_sendPort ??= _spawn());
+    final id = _id++;
+    final completer = Completer<List<Playable>>();
+    _completers[id] = completer;
+    sendPort.send((id, extras));
+    return completer.future;
+  }
+
+  Future<SendPort> _spawn() async {
+    final receivePort = ReceivePort();
+    final sendPort = Completer<SendPort>();
+    receivePort.listen((message) {
+      switch (message) {
+        case SendPort port:
+          sendPort.complete(port);
+        case (int id, List<Playable> playables):
+          _completers.remove(id)?.complete(playables);
+        case (int id, String error):
+          _completers.remove(id)?.completeError(StateError(error));
+        default:
+          // Uncaught error (List of error & stack trace) or exit (null): the worker is gone, a new one is spawned upon the next call.
+          debugPrint('PlayableMapper: _spawn: Worker exited: $message');
+          if (!sendPort.isCompleted) sendPort.completeError(StateError('PlayableMapper worker exited.'));
+          _isolate = null;
+          _reset(StateError('PlayableMapper worker exited.'));
+      }
+    });
+    _receivePort = receivePort;
+    _isolate = await Isolate.spawn(
+      _main,
+      receivePort.sendPort,
+      onError: receivePort.sendPort,
+      onExit: receivePort.sendPort,
+      debugName: 'PlayableMapper',
+    );
+    return sendPort.future;
+  }
+
+  /// Fails the pending calls with [error] & discards the worker.
+  void _reset(Object error) {
+    _receivePort?.close();
+    _receivePort = null;
+    _sendPort = null;
+    for (final completer in _completers.values) {
+      completer.completeError(error);
+    }
+    _completers.clear();
+  }
+
+  static void _main(SendPort sendPort) {
+    final receivePort = ReceivePort();
+    sendPort.send(receivePort.sendPort);
+    receivePort.listen((message) {
+      final (int id, List<Map<String, dynamic>?> extras) = message as (int, List<Map<String, dynamic>?>);
+      try {
+        sendPort.send((id, [for (final e in extras) Playable.fromJson(e ?? {})]));
+      } catch (exception) {
+        sendPort.send((id, exception.toString()));
+      }
+    });
+  }
+
+  Isolate? _isolate;
+  ReceivePort? _receivePort;
+  Future<SendPort>? _sendPort;
+  int _id = 0;
+  final HashMap<int, Completer<List<Playable>>> _completers = HashMap<int, Completer<List<Playable>>>();
+}
@@ -0,0 +1,287 @@
+import 'dart:async';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:math';
+import 'dart:typed_data';
+import 'package:flutter/foundation.dart';
+import 'package:path/path.dart';
+import 'package:synchronized/synchronized.dart';
+
+import 'package:harmonoid/core/media_player/models/playable.dart';
+
+/// {@template playback_queue_journal}
+///
+/// PlaybackQueueJournal
+/// --------------------
+/// Implementation to persist the playback queue as a binary journal of edits.
+///
+/// Each change to the queue is appended as a splice (start, removed count & inserted [Playable]s) or an index record, so saving the
+/// queue costs as much as the change itself. Once the journal grows past twice its last snapshot, it is compacted into a single splice
+/// on a separate isolate.
+///
+/// {@endtemplate}
+class PlaybackQueueJournal {
+  static const String kFileName = 'PlaybackQueue.BIN';
+
+  /// Minimum size (in bytes) of the journal before it is considered for compaction.
+  static const int kCompactionThreshold = 256 * 1024;
+
+  /// Singleton instance.
+  static final PlaybackQueueJournal instance = PlaybackQueueJournal._();
+
+  /// Whether the [instance] is initialized.
+  static bool initialized = false;
+
+  /// {@macro playback_queue_journal}
+  PlaybackQueueJournal._();
+
+  /// Initializes the [instance]. Reads the journal (if any) on a separate isolate.
+  static Future<void> ensureInitialized({required Directory directory}) async {
+    if (initialized) return;
+    initialized = true;
+    instance._file = File(join(directory.path, kFileName));
+    try {
+      final path = instance._file.path;
+      final result = await Isolate.run(() => _PlaybackQueueJournalCodec.read(path));
+      if (result != null) {
+        instance._playables = result.$1;
+        instance._index = result.$2;
+        instance._size = instance._snapshotSize = result.$3;
+        instance.available = true;
+      }
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+    }
+  }
+
+  /// Whether the journal is present; i.e. read upon initialization or written by [start].
+  bool available = false;
+
+  /// [Playable]s read from the journal.
+  List<Playable> get playables => _playables;
+
+  /// Index read from the journal.
+  int get index => max(_index, 0);
+
+  /// Starts recording the changes passed to [update]. Must be invoked after the playback state is restored, so that the (empty) initial
+  /// state is not recorded. [playables] & [index] must be the restored queue (not the one mapped from the player, which may still be
+  /// empty); if the journal was not [available] (e.g. first launch after an upgrade), these are written as the initial snapshot.
+  Future<void> start(List<Playable> playables, int index) {
+    _started = true;
+    if (available) return update(playables, index);
+    return _lock.synchronized(() async {
+      try {
+        _playables = playables;
+        _index = index;
+        await _compact();
+        available = true;
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    });
+  }
+
+  /// Records the difference between the previously recorded queue & [playables] / [index].
+  Future<void> update(List<Playable> playables, int index) {
+    if (!_started || (identical(playables, _playables) && index == _index)) return Future.value();
+    return _lock.synchronized(() async {
+      try {
+        final builder = BytesBuilder(copy: false);
+        if (!identical(playables, _playables)) {
+          final previous = _playables;
+          final n = previous.length;
+          final m = playables.length;
+          var prefix = 0;
+          while (prefix < n && prefix < m && previous[prefix] == playables[prefix]) {
+            prefix++;
+          }
+          var suffix = 0;
+          while (suffix < n - prefix && suffix < m - prefix && previous[n - 1 - suffix] == playables[m - 1 - suffix]) {
+            suffix++;
+          }
+          if (prefix != n || prefix != m) {
+            builder.add(_PlaybackQueueJournalCodec.encodeSplice(prefix, n - prefix - suffix, playables.sublist(prefix, m - suffix)));
+          }
+        }
+        if (index != _index) {
+          builder.add(_PlaybackQueueJournalCodec.encodeIndex(index));
+        }
+        _playables = playables;
+        _index = index;
+        if (builder.isEmpty) return;
+
+        final bytes = builder.takeBytes();
+        if (_size + bytes.length > max(kCompactionThreshold, _snapshotSize * 2)) {
+          await _compact();
+        } else {
+          final file = _raf ??= await _file.open(mode: FileMode.append);
+          await file.writeFrom(bytes);
+          await file.flush();
+          _size += bytes.length;
+        }
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    });
+  }
+
+  /// Disposes the [instance]. Releases allocated resources back to the system.
+  Future<void> dispose() {
+    return _lock.synchronized(() async {
+      await _raf?.close();
+      _raf = null;
+    });
+  }
+
+  /// Re-writes the journal as a single splice & index.
+  Future<void> _compact() async {
+    await _raf?.close();
+    _raf = null;
+    final path = _file.path;
+    final playables = _playables;
+    final index = _index;
+    _size = _snapshotSize = await Isolate.run(() => _PlaybackQueueJournalCodec.write(path, playables, index));
+    debugPrint('PlaybackQueueJournal: _compact: ${playables.length} playables, $_size bytes');
+  }
+
+  /// Journal file.
+  late final File _file;
+
+  /// Currently opened journal file (for appending).
+  RandomAccessFile? _raf;
+
+  /// Last recorded [Playable]s.
+  List<Playable> _playables = const [];
+
+  /// Last recorded index.
+  int _index = -1;
+
+  /// Current size (in bytes) of the journal.
+  int _size = 0;
+
+  /// Size (in bytes) of the journal after the last compaction.
+  int _snapshotSize = 0;
+
+  /// Whether [start] has been invoked.
+  bool _started = false;
+
+  /// Mutual exclusion in [update] invocations.
+  final Lock _lock = Lock();
+}
+
+/// Each record (little endian) starts with a uint8 operation:
+/// * [kSplice]: uint32 start, uint32 removed count, uint32 inserted count & inserted [Playable]s.
+/// * [kIndex]: uint32 index.
+///
+/// Each [Playable] is: string uri, string title, uint8 count & strings of subtitle, uint8 count & strings of description; where each
+/// string is uint32 length & utf8 bytes.
+abstract class _PlaybackQueueJournalCodec {
+  static const int kSplice = 0;
+  static const int kIndex = 1;
+
+  static Uint8List encodeSplice(int start, int removed, List<Playable> inserted) {
+    final builder = BytesBuilder(copy: false);
+    final header = ByteData(13);
+    header.setUint8(0, kSplice);
+    header.setUint32(1, start, Endian.little);
+    header.setUint32(5, removed, Endian.little);
+    header.setUint32(9, inserted.length, Endian.little);
+    builder.add(header.buffer.asUint8List());
+    for (final playable in inserted) {
+      _addString(builder, playable.uri);
+      _addString(builder, playable.title);
+      builder.addByte(min(playable.subtitle.length, 255));
+      playable.subtitle.take(255).forEach((e) => _addString(builder, e));
+      builder.addByte(min(playable.description.length, 255));
+      playable.description.take(255).forEach((e) => _addString(builder, e));
+    }
+    return builder.takeBytes();
+  }
+
+  static Uint8List encodeIndex(int index) {
+    final data = ByteData(5);
+    data.setUint8(0, kIndex);
+    data.setUint32(1, max(index, 0), Endian.little);
+    return data.buffer.asUint8List();
+  }
+
+  /// Replays the journal at [path]. Returns the [Playable]s, index & size of the journal; or null if the journal does not exist.
+  static (List<Playable>, int, int)? read(String path) {
+    final file = File(path);
+    if (!file.existsSync()) return null;
+    final bytes = file.readAsBytesSync();
+    final data = ByteData.sublistView(bytes);
+    final playables = <Playable>[];
+    var index = 0;
+    var offset = 0;
+    // NOTE: A partially written record at the end (e.g. power loss) is ignored.
+    try {
+      while (offset < bytes.length) {
+        final operation = data.getUint8(offset);
+        if (operation == kSplice) {
+          var position = offset + 13;
+          final start = data.getUint32(offset + 1, Endian.little);
+          final removed = data.getUint32(offset + 5, Endian.little);
+          final count = data.getUint32(offset + 9, Endian.little);
+          final inserted = <Playable>[];
+          String readString() {
+            final length = data.getUint32(position, Endian.little);
+            if (position + 4 + length > bytes.length) throw RangeError.range(position + 4 + length, 0, bytes.length);
+            final result = utf8.decode(Uint8List.sublistView(bytes, position + 4, position + 4 + length), allowMalformed: true);
+            position += 4 + length;
+            return result;
+          }
+
+          List<String> readStrings() {
+            final count = data.getUint8(position++);
+            return List<String>.generate(count, (_) => readString());
+          }
+
+          for (var i = 0; i < count; i++) {
+            inserted.add(Playable(uri: readString(), title: readString(), subtitle: readStrings(), description: readStrings()));
+          }
+          if (start + removed > playables.length) break;
+          playables.replaceRange(start, start + removed, inserted);
+          offset = position;
+        } else if (operation == kIndex) {
+          index = data.getUint32(offset + 1, Endian.little);
+          offset += 5;
+        } else {
+          break;
+        }
+      }
+    } on RangeError catch (_) {
+      // Incomplete record.
+    }
+    if (offset < bytes.length) {
+      // Drop the incomplete record, so that subsequent records are appended after a valid one.
+      final raf = file.openSync(mode: FileMode.append);
+      raf.truncateSync(offset);
+      raf.closeSync();
+    }
+    return (playables, index.clamp(0, max(playables.length - 1, 0)), offset);
+  }
+
+  /// Writes [playables] & [index] as a new journal at [path]. Returns the size of the journal.
+  static int write(String path, List<Playable> playables, int index) {
+    final builder = BytesBuilder(copy: false);
+    builder.add(encodeSplice(0, 0, playables));
+    builder.add(encodeIndex(index));
+    final bytes = builder.takeBytes();
+    final temp = File('$path.tmp');
+    temp.writeAsBytesSync(bytes, flush: true);
+    temp.renameSync(path);
+    return bytes.length;
+  }
+
+  static void _addString(BytesBuilder builder, String value) {
+    final bytes = utf8.encode(value);
+    final length = ByteData(4)..setUint32(0, bytes.length, Endian.little);
+    builder.add(length.buffer.asUint8List());
+    builder.add(bytes);
+  }
+}
@@ -0,0 +1,171 @@
+import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:io';
+import 'package:crypto/crypto.dart';
+import 'package:flutter/foundation.dart';
+import 'package:path/path.dart';
+import 'package:safe_local_storage/safe_local_storage.dart';
+
+/// {@template read_ahead_cache}
+///
+/// ReadAheadCache
+/// --------------
+/// Implementation to copy upcoming files to a bounded local cache, so that track changes do not wait for slow (e.g. network) storage.
+///
+/// The first [kProbeSize] bytes of a file are read once per directory; if that takes less than [kProbeThreshold], the storage is considered
+/// fast & files from that directory are left as-is. Copies are written to a temporary file & only reported once complete. Least recently
+/// used copies are evicted above [kCapacity] bytes; retained copies (e.g. the ones the playlist still points to) are never evicted, files
+/// which do not fit alongside them are not copied.
+///
+/// {@endtemplate}
+class ReadAheadCache {
+  static const String kDirectoryName = 'ReadAhead';
+
+  /// Number of upcoming URIs to copy.
+  static const int kCount = 2;
+
+  /// Maximum size (in bytes) of the cache.
+  static const int kCapacity = 1024 * 1024 * 1024;
+  static const int kProbeSize = 256 * 1024;
+  static const Duration kProbeThreshold = Duration(milliseconds: 40);
+
+  /// {@macro read_ahead_cache}
+  ReadAheadCache({required Directory directory}) : _directory = directory;
+
+  /// Returns the path of the complete copy of [uri], if any.
+  String? lookup(String uri) {
+    final entry = _entries.remove(uri);
+    if (entry == null) return null;
+    // Most recently used.
+    _entries[uri] = entry;
+    return entry.$1;
+  }
+
+  /// Copies [uris] one at a time (unless already copied) & invokes [onComplete] with the path of each copy. Copies of [uris] & [retain]
+  /// are not evicted. Only the most recently requested URIs are considered.
+  void prefetch(
+    Iterable<String> uris, {
+    Iterable<String> retain = const [],
+    required FutureOr<void> Function(String uri, String path) onComplete,
+  }) {
+    if (_disposed) return;
+    _queue
+      ..clear()
+      ..addAll(uris.where(_eligible));
+    _retained
+      ..clear()
+      ..addAll(_queue)
+      ..addAll(retain);
+    _onComplete = onComplete;
+    if (_running) return;
+    _running = true;
+    _run().whenComplete(() => _running = false);
+  }
+
+  /// Disposes the instance.
+  Future<void> dispose() async {
+    _disposed = true;
+    _queue.clear();
+  }
+
+  Future<void> _run() async {
+    while (!_disposed && _queue.isNotEmpty) {
+      final uri = _queue.removeFirst();
+      try {
+        final path = lookup(uri) ?? await _copy(uri);
+        if (path == null || _disposed) continue;
+        await _onComplete?.call(uri, path);
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    }
+  }
+
+  Future<String?> _copy(String uri) async {
+    if (!_initialized) {
+      _initialized = true;
+      // Copies of the previous session are not indexed.
+      if (await _directory.exists_()) {
+        await _directory.delete(recursive: true);
+      }
+      await _directory.create_();
+    }
+
+    final source = File(uri);
+    final fast = _fast[dirname(uri)] ??= await _probe(source);
+    if (fast) return null;
+
+    final length = await source.length();
+    // Not worth evicting everything else for e.g. a long mix.
+    if (length > kCapacity ~/ 4) return null;
+    if (!await _evict(length)) return null;
+
+    final stopwatch = Stopwatch()..start();
+    final destination = File(join(_directory.path, '${sha256.convert(utf8.encode(uri))}${extension(uri)}'));
+    final temp = File('${destination.path}.tmp');
+    await source.openRead().pipe(temp.openWrite());
+    await temp.rename(destination.path);
+    _entries[uri] = (destination.path, length);
+    _size += length;
+
+    debugPrint('ReadAheadCache: _copy: URI: $uri, Size: $length, Elapsed: ${stopwatch.elapsedMilliseconds} ms');
+    return destination.path;
+  }
+
+  /// Returns whether the first [kProbeSize] bytes of [source] are read within [kProbeThreshold].
+  Future<bool> _probe(File source) async {
+    final stopwatch = Stopwatch()..start();
+    final file = await source.open();
+    try {
+      await file.read(kProbeSize);
+    } finally {
+      await file.close();
+    }
+    debugPrint('ReadAheadCache: _probe: Directory: ${source.parent.path}, Elapsed: ${stopwatch.elapsedMilliseconds} ms');
+    return stopwatch.elapsed < kProbeThreshold;
+  }
+
+  /// Evicts the least recently used copies until [length] bytes fit within [kCapacity]. Returns whether these fit.
+  Future<bool> _evict(int length) async {
+    for (final uri in _entries.keys.toList()) {
+      if (_size + length <= kCapacity) break;
+      if (_retained.contains(uri)) continue;
+      final (path, size) = _entries.remove(uri)!;
+      _size -= size;
+      try {
+        await File(path).delete_();
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    }
+    return _size + length <= kCapacity;
+  }
+
+  /// Only local files are copied; other URIs are either streamed or already local (e.g. content:// on Android).
+  static bool _eligible(String uri) => !uri.contains('://') && !Platform.isAndroid && !Platform.isIOS;
+
+  final Directory _directory;
+
+  /// Complete copies (path & size) by URI; in the order of access.
+  final LinkedHashMap<String, (String, int)> _entries = LinkedHashMap<String, (String, int)>();
+
+  /// URIs pending to be copied.
+  final ListQueue<String> _queue = ListQueue<String>();
+
+  /// URIs whose copies are not evicted.
+  final HashSet<String> _retained = HashSet<String>();
+
+  /// Whether the storage is fast by directory.
+  final HashMap<String, bool> _fast = HashMap<String, bool>();
+
+  /// Total size (in bytes) of the copies.
+  int _size = 0;
+
+  FutureOr<void> Function(String uri, String path)? _onComplete;
+  bool _initialized = false;
+  bool _running = false;
+  bool _disposed = false;
+}
@@ -0,0 +1,183 @@
+import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:math';
+import 'package:flutter/foundation.dart';
+import 'package:lastfm/lastfm.dart';
+import 'package:path/path.dart';
+import 'package:synchronized/synchronized.dart';
+
+import 'package:harmonoid/core/media_player/mixin/api/track_scrobble.dart';
+
+/// {@template scrobble_queue}
+///
+/// ScrobbleQueue
+/// -------------
+/// Implementation to persist [ScrobbleRequest]s on disk & submit them to Last.fm in batches.
+///
+/// Each [ScrobbleRequest] is appended to [kFileName] as a JSON line before anything else, so that plays are not lost while offline or
+/// if the application is closed. A background worker submits up to [TrackScrobble.kBatchSize] at once & removes them from the file
+/// once accepted. Failures are retried with exponential backoff between [kMinBackoff] & [kMaxBackoff].
+///
+/// {@endtemplate}
+class ScrobbleQueue {
+  static const String kFileName = 'LastFmScrobbles.JSONL';
+  static const Duration kMinBackoff = Duration(seconds: 15);
+  static const Duration kMaxBackoff = Duration(hours: 1);
+
+  /// {@macro scrobble_queue}
+  ScrobbleQueue({
+    required Directory directory,
+    required TrackScrobble trackScrobble,
+    required String? Function() sessionKey,
+  }) : _file = File(join(directory.path, kFileName)),
+       _trackScrobble = trackScrobble,
+       _sessionKey = sessionKey;
+
+  /// Number of pending [ScrobbleRequest]s.
+  int get length => _requests.length;
+
+  /// Reads the pending [ScrobbleRequest]s & starts submitting them.
+  Future<void> ensureInitialized() async {
+    await _lock.synchronized(() async {
+      try {
+        if (await _file.exists()) {
+          for (final line in await _file.readAsLines()) {
+            try {
+              _requests.add(_decode(json.decode(line)));
+            } catch (_) {
+              // Partially written line e.g. power loss.
+            }
+          }
+        }
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    });
+    debugPrint('ScrobbleQueue: ensureInitialized: ${_requests.length} pending');
+    notify();
+  }
+
+  /// Adds [request] to the queue.
+  Future<void> add(ScrobbleRequest request) async {
+    await _lock.synchronized(() async {
+      _requests.add(request);
+      try {
+        await _file.writeAsString('${json.encode(_encode(request))}\n', mode: FileMode.append, flush: true);
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    });
+    notify();
+  }
+
+  /// Starts submitting the pending [ScrobbleRequest]s, unless already submitting or waiting for backoff. Invoke after the session changes.
+  void notify() {
+    if (_disposed || _running || _backoffTimer != null) return;
+    _running = true;
+    _submit().whenComplete(() => _running = false);
+  }
+
+  /// Disposes the instance.
+  Future<void> dispose() async {
+    _disposed = true;
+    _backoffTimer?.cancel();
+    _backoffTimer = null;
+    await _lock.synchronized(() {});
+  }
+
+  Future<void> _submit() async {
+    while (!_disposed && _requests.isNotEmpty) {
+      final sessionKey = _sessionKey();
+      // Resumed by [notify] once connected.
+      if (sessionKey == null || sessionKey.isEmpty) return;
+
+      final batch = _requests.take(TrackScrobble.kBatchSize).toList();
+      try {
+        final accepted = await _trackScrobble(sessionKey, batch);
+        debugPrint('ScrobbleQueue: _submit: Submitted: ${batch.length}, Accepted: $accepted');
+        await _remove(batch.length);
+        _attempt = 0;
+      } on TrackScrobbleException catch (exception) {
+        debugPrint(exception.toString());
+        if (exception.session) {
+          // Resumed by [notify] once the session is renewed.
+          return;
+        }
+        if (!exception.retryable) {
+          // Malformed scrobbles are never going to be accepted.
+          await _remove(batch.length);
+          continue;
+        }
+        _backoff();
+        return;
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+        _backoff();
+        return;
+      }
+    }
+  }
+
+  void _backoff() {
+    final delay = Duration(milliseconds: min(kMinBackoff.inMilliseconds * pow(2, _attempt++).toInt(), kMaxBackoff.inMilliseconds));
+    debugPrint('ScrobbleQueue: _backoff: $delay');
+    _backoffTimer = Timer(delay, () {
+      _backoffTimer = null;
+      notify();
+    });
+  }
+
+  /// Removes the first [count] [ScrobbleRequest]s & re-writes the file.
+  Future<void> _remove(int count) {
+    return _lock.synchronized(() async {
+      for (var i = 0; i < count && _requests.isNotEmpty; i++) {
+        _requests.removeFirst();
+      }
+      try {
+        final temp = File('${_file.path}.tmp');
+        await temp.writeAsString(_requests.map((e) => '${json.encode(_encode(e))}\n').join(), flush: true);
+        await temp.rename(_file.path);
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    });
+  }
+
+  static Map<String, dynamic> _encode(ScrobbleRequest request) => {
+    'artist': request.artist,
+    'track': request.track,
+    'album': request.album,
+    'timestamp': request.timestamp,
+    'duration': request.duration,
+  };
+
+  static ScrobbleRequest _decode(dynamic json) => ScrobbleRequest(
+    artist: json['artist'],
+    track: json['track'],
+    album: json['album'],
+    timestamp: json['timestamp'],
+    duration: json['duration'],
+  );
+
+  final File _file;
+  final TrackScrobble _trackScrobble;
+  final String? Function() _sessionKey;
+
+  /// Pending [ScrobbleRequest]s; in the order of playback.
+  final ListQueue<ScrobbleRequest> _requests = ListQueue<ScrobbleRequest>();
+
+  /// Number of consecutive failed attempts.
+  int _attempt = 0;
+  Timer? _backoffTimer;
+  bool _running = false;
+  bool _disposed = false;
+
+  /// Mutual exclusion in file operations.
+  final Lock _lock = Lock();
+}
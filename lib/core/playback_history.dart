@@ -0,0 +1,140 @@
+import 'dart:async';
+import 'package:flutter/foundation.dart';
+import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
+import 'package:synchronized/synchronized.dart';
+
+import 'package:harmonoid/core/filesystem_media_library.dart';
+import 'package:harmonoid/core/media_player/models/playable.dart';
+import 'package:harmonoid/extensions/playable.dart';
+
+/// {@template playback_history}
+///
+/// PlaybackHistory
+/// ---------------
+/// Implementation to record the played [Playable]s in the history playlist.
+///
+/// [add] only appends to an in-memory buffer, so the player state path never waits for the database. The buffer is written after
+/// [kFlushInterval] or once it holds [kBatchSize] entries. Every [kPruneInterval] written entries, the oldest entries beyond [kCapacity]
+/// are removed. Each write & each prune is grouped into a single database transaction. [entries] reads the history playlist in pages &
+/// keeps it in memory until the next write.
+///
+/// {@endtemplate}
+class PlaybackHistory {
+  /// Number of pending entries after which the buffer is written immediately.
+  static const int kBatchSize = 16;
+
+  /// Interval after which pending entries are written.
+  static const Duration kFlushInterval = Duration(seconds: 30);
+
+  /// Maximum number of entries in the history playlist.
+  static const int kCapacity = 5000;
+
+  /// Number of written entries after which the history playlist is pruned.
+  static const int kPruneInterval = 256;
+
+  /// Singleton instance.
+  static final PlaybackHistory instance = PlaybackHistory._();
+
+  /// {@macro playback_history}
+  PlaybackHistory._();
+
+  /// Records [playable] as played.
+  void add(Playable playable) {
+    _pending.add((playable.uri, playable.playlistEntryTitle));
+    if (_pending.length >= kBatchSize) {
+      unawaited(flush());
+    } else {
+      _flushTimer ??= Timer(kFlushInterval, flush);
+    }
+  }
+
+  /// Returns [limit] entries of the history playlist starting at [offset] (or all entries, if [limit] is null). Pending entries are
+  /// written first.
+  Future<List<PlaylistEntry>> entries({int offset = 0, int? limit}) async {
+    await flush();
+    final entries = _entries ??= await FileSystemMediaLibrary.instance.playlists.playlistEntries(FileSystemMediaLibrary.instance.playlists.historyPlaylist);
+    final start = offset.clamp(0, entries.length);
+    final end = limit == null ? entries.length : (start + limit).clamp(start, entries.length);
+    return entries.sublist(start, end);
+  }
+
+  /// Discards the entries kept in memory; invoke after modifying the history playlist elsewhere.
+  void invalidate() {
+    _entries = null;
+  }
+
+  /// Writes the pending entries to the history playlist.
+  Future<void> flush() {
+    _flushTimer?.cancel();
+    _flushTimer = null;
+    if (_pending.isEmpty) return _lock.synchronized(() {});
+    final pending = List.of(_pending);
+    _pending.clear();
+    return _lock.synchronized(() async {
+      try {
+        await _insert(pending);
+        _entries = null;
+        _written += pending.length;
+        if (_written >= kPruneInterval) {
+          _written = 0;
+          await _prune();
+        }
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    });
+  }
+
+  /// Disposes the [instance]. Writes the pending entries.
+  Future<void> dispose() => flush();
+
+  /// Removes the oldest entries beyond [kCapacity].
+  Future<void> _prune() async {
+    final entries = _entries ??= await FileSystemMediaLibrary.instance.playlists.playlistEntries(FileSystemMediaLibrary.instance.playlists.historyPlaylist);
+    final count = entries.length - kCapacity;
+    if (count <= 0) return;
+    // NOTE: Entries are returned in the order of insertion i.e. oldest first.
+    await _delete(entries.sublist(0, count));
+    _entries = null;
+    debugPrint('PlaybackHistory: _prune: Removed: $count');
+  }
+
+  /// Inserts [values] (URI & title) into the history playlist, in a single transaction.
+  static Future<void> _insert(List<(String, String)> values) {
+    return FileSystemMediaLibrary.instance.db.transaction(() async {
+      for (final (uri, title) in values) {
+        // TODO: Add support for HTTP URIs.
+        final track = FileSystemMediaLibrary.instance.lookupTrack(TrackLookupKey(uri: uri));
+        if (track != null) {
+          // Save as track i.e. hash + title.
+          await FileSystemMediaLibrary.instance.playlists.addToHistory(track: track);
+        } else {
+          // Save as uri + title.
+          await FileSystemMediaLibrary.instance.playlists.addToHistory(uri: uri, title: title);
+        }
+      }
+    });
+  }
+
+  /// Deletes [values] from the history playlist, in a single transaction.
+  static Future<void> _delete(List<PlaylistEntry> values) {
+    return FileSystemMediaLibrary.instance.db.transaction(() async {
+      for (final entry in values) {
+        await FileSystemMediaLibrary.instance.playlists.deleteEntry(entry);
+      }
+    });
+  }
+
+  /// Entries (URI & title) pending to be written.
+  final List<(String, String)> _pending = <(String, String)>[];
+
+  /// Entries of the history playlist read by [entries]; discarded upon write.
+  List<PlaylistEntry>? _entries;
+
+  /// Number of entries written since the last prune.
+  int _written = 0;
+
+  final Lock _lock = Lock();
+  Timer? _flushTimer;
+}
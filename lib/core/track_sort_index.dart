@@ -0,0 +1,354 @@
+import 'dart:collection';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+import 'package:flutter/foundation.dart';
+import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
+import 'package:path/path.dart';
+
+import 'package:harmonoid/core/filesystem_media_library.dart';
+import 'package:harmonoid/core/media_library_search_index.dart';
+import 'package:harmonoid/utils/debouncer.dart';
+
+/// {@template track_sort_index}
+///
+/// TrackSortIndex
+/// --------------
+/// Implementation to keep the tracks of [FileSystemMediaLibrary] sorted by every [TrackSortType] at once.
+///
+/// Switching the [TrackSortType] or direction is a lookup (descending order is a reversed view), not a re-sort. The sort keys are
+/// diacritic-folded & lower-cased once ([MediaLibrarySearchIndex.fold]), then compared as plain strings.
+///
+/// The orders are persisted to the media library cache as permutations, along with a hash of each URI & of its sort keys; a later launch
+/// re-uses them as long as the media library contains the same URIs with the same sort keys. When the media library changes, only the
+/// inserted & removed tracks are processed.
+///
+/// {@endtemplate}
+class TrackSortIndex extends ChangeNotifier {
+  static const String kFileName = 'TrackSortIndex.BIN';
+  static const int kVersion = 2;
+
+  /// Singleton instance.
+  static final TrackSortIndex instance = TrackSortIndex._();
+
+  /// Whether the [instance] is initialized.
+  static bool initialized = false;
+
+  /// {@macro track_sort_index}
+  TrackSortIndex._();
+
+  /// Initializes the [instance].
+  static Future<void> ensureInitialized() async {
+    if (initialized) return;
+    initialized = true;
+    FileSystemMediaLibrary.instance.addListener(instance._listener);
+    instance._update();
+  }
+
+  /// Returns the tracks sorted by [type] in the given direction; null if not yet available.
+  List<Track>? sorted(TrackSortType type, bool ascending) {
+    final result = _sorted[type];
+    if (result == null) return null;
+    return ascending ? result : _ReversedList<Track>(result);
+  }
+
+  /// Returns [tracks] sorted by [type] in the given direction, consistent with [sorted]; for use until the index is available.
+  static List<Track> sort(List<Track> tracks, TrackSortType type, bool ascending) {
+    final keys = _TrackSortIndexKeys.of(tracks);
+    final order = _TrackSortIndexCodec.sort(type, keys, keys.titles.map(MediaLibrarySearchIndex.fold).toList());
+    final result = [for (final i in order) tracks[i]];
+    return ascending ? result : result.reversed.toList();
+  }
+
+  /// Disposes the [instance]. Releases allocated resources back to the system.
+  @override
+  void dispose() {
+    _debouncer.dispose();
+    FileSystemMediaLibrary.instance.removeListener(_listener);
+    super.dispose();
+  }
+
+  void _listener() {
+    final generation = FileSystemMediaLibrary.instance.generation(MediaLibraryCollection.tracks);
+    if (_generation == generation) return;
+    _generation = generation;
+    // NOTE: The media library notifies frequently during a refresh, coalesce those into a single update.
+    _debouncer.run(_update);
+  }
+
+  Future<void> _update() async {
+    if (_updating) {
+      _dirty = true;
+      return;
+    }
+    _updating = true;
+    _dirty = false;
+    try {
+      await _apply();
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+    } finally {
+      _updating = false;
+      if (_dirty) _update();
+    }
+  }
+
+  Future<void> _apply() async {
+    final tracks = FileSystemMediaLibrary.instance.tracks.toList();
+    final current = HashSet<Track>.of(tracks);
+
+    if (_sorted.isNotEmpty) {
+      final removed = _tracks.where((e) => !current.contains(e)).toSet();
+      final added = tracks.where((e) => !_tracks.contains(e)).toList();
+      if (removed.isEmpty && added.isEmpty) return;
+      if (removed.length + added.length < tracks.length ~/ 2) {
+        for (final type in TrackSortType.values) {
+          _sorted[type] = _merge(type, _sorted[type]!.where((e) => !removed.contains(e)).toList(), added);
+        }
+        _tracks = current;
+        notifyListeners();
+        debugPrint('TrackSortIndex: _apply: Removed: ${removed.length}, Added: ${added.length}');
+        await _save(tracks);
+        return;
+      }
+    }
+
+    final (permutations, loaded) = await _obtain(join(FileSystemMediaLibrary.instance.cache.path, kFileName), _TrackSortIndexKeys.of(tracks));
+    _sorted
+      ..clear()
+      ..addAll({for (final type in TrackSortType.values) type: [for (final i in permutations[type.index]) tracks[i]]});
+    _tracks = current;
+    notifyListeners();
+    debugPrint('TrackSortIndex: _apply: Tracks: ${tracks.length}, Loaded: $loaded');
+  }
+
+  /// Persists the current orders as permutations of [tracks].
+  Future<void> _save(List<Track> tracks) async {
+    final positions = HashMap<Track, int>();
+    for (var i = 0; i < tracks.length; i++) {
+      positions[tracks[i]] = i;
+    }
+    final permutations = [
+      for (final type in TrackSortType.values) Uint32List.fromList([for (final e in _sorted[type]!) positions[e]!]),
+    ];
+    await _write(join(FileSystemMediaLibrary.instance.cache.path, kFileName), _TrackSortIndexKeys.of(tracks), permutations);
+  }
+
+  // NOTE: Static, so that the closures sent to the isolates only capture the arguments.
+
+  static Future<(List<Uint32List>, bool)> _obtain(String path, _TrackSortIndexKeys keys) {
+    return Isolate.run(() => _TrackSortIndexCodec.obtain(path, keys));
+  }
+
+  static Future<void> _write(String path, _TrackSortIndexKeys keys, List<Uint32List> permutations) {
+    return Isolate.run(() => _TrackSortIndexCodec.write(path, keys, permutations));
+  }
+
+  /// Inserts [added] into [sorted] (ordered by [type]).
+  static List<Track> _merge(TrackSortType type, List<Track> sorted, List<Track> added) {
+    if (added.isEmpty) return sorted;
+    final keys = _TrackSortIndexKeys.of(added);
+    final order = _TrackSortIndexCodec.sort(type, keys, keys.titles.map(MediaLibrarySearchIndex.fold).toList());
+    final result = <Track>[];
+    var i = 0;
+    for (final j in order) {
+      final track = added[j];
+      // Keys of the existing tracks are computed on demand; only O(log n) of them per inserted track.
+      var lo = i;
+      var hi = sorted.length;
+      while (lo < hi) {
+        final mid = (lo + hi) >> 1;
+        if (_TrackSortIndexKeys.compare(type, sorted[mid], track) <= 0) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      result.addAll(sorted.getRange(i, lo));
+      result.add(track);
+      i = lo;
+    }
+    result.addAll(sorted.getRange(i, sorted.length));
+    return result;
+  }
+
+  /// Tracks present in [_sorted].
+  HashSet<Track> _tracks = HashSet<Track>();
+
+  /// Tracks sorted in ascending order by each [TrackSortType].
+  final Map<TrackSortType, List<Track>> _sorted = <TrackSortType, List<Track>>{};
+
+  /// [FileSystemMediaLibrary.generation] of the tracks at the last notification.
+  int? _generation;
+
+  bool _updating = false;
+  bool _dirty = false;
+  final Debouncer _debouncer = Debouncer();
+}
+
+/// Sort keys of a list of [Track]s, in a form which can be sent to another isolate.
+class _TrackSortIndexKeys {
+  final List<String> uris;
+  final List<String> titles;
+  final Int64List timestamps;
+  final Int32List years;
+
+  const _TrackSortIndexKeys(this.uris, this.titles, this.timestamps, this.years);
+
+  factory _TrackSortIndexKeys.of(List<Track> tracks) {
+    return _TrackSortIndexKeys(
+      [for (final e in tracks) e.uri],
+      [for (final e in tracks) e.title],
+      Int64List.fromList([for (final e in tracks) e.timestamp.millisecondsSinceEpoch]),
+      Int32List.fromList([for (final e in tracks) e.year]),
+    );
+  }
+
+  int get length => uris.length;
+
+  /// Hash of the sort keys (except the URI) of the entry at [index].
+  int hash(int index) => _TrackSortIndexCodec.hash('${titles[index]}\u0000${timestamps[index]}\u0000${years[index]}');
+
+  /// Compares [a] & [b] by [type]; consistent with [_TrackSortIndexCodec.sort].
+  static int compare(TrackSortType type, Track a, Track b) {
+    int result = switch (type) {
+      TrackSortType.title => 0,
+      TrackSortType.timestamp => a.timestamp.millisecondsSinceEpoch.compareTo(b.timestamp.millisecondsSinceEpoch),
+      TrackSortType.year => a.year.compareTo(b.year),
+    };
+    if (result != 0) return result;
+    result = MediaLibrarySearchIndex.fold(a.title).compareTo(MediaLibrarySearchIndex.fold(b.title));
+    if (result != 0) return result;
+    return a.uri.compareTo(b.uri);
+  }
+}
+
+/// File format (little endian): uint32 version, uint32 count, uint64 hash of each URI & uint64 hash of its sort keys (in the order at the
+/// time of writing) & uint32 permutation (of the same order) of count entries for each [TrackSortType]. The order of
+/// [FileSystemMediaLibrary.tracks] depends on its own sort type, hence the URI hashes to map the entries back; the sort key hashes detect
+/// tracks modified without a change of URI (e.g. edited while the application was closed).
+abstract class _TrackSortIndexCodec {
+  /// Returns the permutation (of [keys]) for each [TrackSortType] from the file at [path] if it contains the same keys, otherwise sorts &
+  /// writes them. The second value is whether the permutations were read from the file.
+  static (List<Uint32List>, bool) obtain(String path, _TrackSortIndexKeys keys) {
+    try {
+      final result = read(path, keys);
+      if (result != null) return (result, true);
+    } catch (_) {}
+    final titles = keys.titles.map(MediaLibrarySearchIndex.fold).toList();
+    final result = [for (final type in TrackSortType.values) sort(type, keys, titles)];
+    try {
+      write(path, keys, result);
+    } catch (_) {}
+    return (result, false);
+  }
+
+  /// Returns the order of [keys] by [type]. [titles] are the folded [_TrackSortIndexKeys.titles].
+  static Uint32List sort(TrackSortType type, _TrackSortIndexKeys keys, List<String> titles) {
+    final order = List<int>.generate(keys.length, (i) => i);
+    order.sort((a, b) {
+      int result = switch (type) {
+        TrackSortType.title => 0,
+        TrackSortType.timestamp => keys.timestamps[a].compareTo(keys.timestamps[b]),
+        TrackSortType.year => keys.years[a].compareTo(keys.years[b]),
+      };
+      if (result != 0) return result;
+      result = titles[a].compareTo(titles[b]);
+      if (result != 0) return result;
+      return keys.uris[a].compareTo(keys.uris[b]);
+    });
+    return Uint32List.fromList(order);
+  }
+
+  /// 64-bit FNV-1a hash of [value].
+  static int hash(String value) {
+    var hash = 0xcbf29ce484222325;
+    for (var i = 0; i < value.length; i++) {
+      hash ^= value.codeUnitAt(i);
+      hash *= 0x100000001b3;
+    }
+    return hash;
+  }
+
+  /// Reads the permutations from the file at [path] & maps them to the order of [keys]. Returns null if the URIs or sort keys do not match.
+  static List<Uint32List>? read(String path, _TrackSortIndexKeys keys) {
+    final file = File(path);
+    if (!file.existsSync()) return null;
+    final bytes = file.readAsBytesSync();
+    final data = ByteData.sublistView(bytes);
+    final uris = keys.uris;
+    final count = uris.length;
+    if (bytes.length != 8 + 16 * count + 4 * count * TrackSortType.values.length) return null;
+    if (data.getUint32(0, Endian.little) != TrackSortIndex.kVersion) return null;
+    if (data.getUint32(4, Endian.little) != count) return null;
+
+    final positions = HashMap<int, int>();
+    for (var i = 0; i < count; i++) {
+      positions[hash(uris[i])] = i;
+    }
+    if (positions.length != count) return null;
+    // Position in [uris] of each entry in the file.
+    final mapping = Uint32List(count);
+    for (var i = 0; i < count; i++) {
+      final position = positions[data.getInt64(8 + 16 * i, Endian.little)];
+      if (position == null) return null;
+      if (data.getInt64(16 + 16 * i, Endian.little) != keys.hash(position)) return null;
+      mapping[i] = position;
+    }
+
+    var offset = 8 + 16 * count;
+    final result = <Uint32List>[];
+    for (var i = 0; i < TrackSortType.values.length; i++) {
+      final permutation = Uint32List(count);
+      for (var j = 0; j < count; j++) {
+        permutation[j] = mapping[data.getUint32(offset, Endian.little)];
+        offset += 4;
+      }
+      result.add(permutation);
+    }
+    return result;
+  }
+
+  /// Writes [permutations] (of [keys]) to the file at [path].
+  static void write(String path, _TrackSortIndexKeys keys, List<Uint32List> permutations) {
+    final count = keys.length;
+    final data = ByteData(8 + 16 * count + 4 * count * permutations.length);
+    data.setUint32(0, TrackSortIndex.kVersion, Endian.little);
+    data.setUint32(4, count, Endian.little);
+    var offset = 8;
+    for (var i = 0; i < count; i++) {
+      data.setInt64(offset, hash(keys.uris[i]), Endian.little);
+      data.setInt64(offset + 8, keys.hash(i), Endian.little);
+      offset += 16;
+    }
+    for (final permutation in permutations) {
+      for (final i in permutation) {
+        data.setUint32(offset, i, Endian.little);
+        offset += 4;
+      }
+    }
+    final temp = File('$path.tmp');
+    temp.writeAsBytesSync(data.buffer.asUint8List(), flush: true);
+    temp.renameSync(path);
+  }
+}
+
+/// Reversed view of a [List].
+class _ReversedList<T> extends ListBase<T> {
+  final List<T> _source;
+
+  _ReversedList(this._source);
+
+  @override
+  int get length => _source.length;
+
+  @override
+  set length(int value) => throw UnsupportedError('Cannot modify an unmodifiable list.');
+
+  @override
+  T operator [](int index) => _source[_source.length - 1 - index];
+
+  @override
+  void operator []=(int index, T value) => throw UnsupportedError('Cannot modify an unmodifiable list.');
+}
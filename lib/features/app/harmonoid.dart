@@ -13,11 +13,15 @@ import 'package:url_launcher/url_launcher_string.dart';
 import 'package:harmonoid/core/configuration/configuration.dart';
 import 'package:harmonoid/core/filesystem_media_library.dart';
 import 'package:harmonoid/core/intent.dart';
+import 'package:harmonoid/core/media_library_watcher.dart';
 import 'package:harmonoid/core/media_player/media_player.dart';
+import 'package:harmonoid/core/media_player/playback_queue_journal.dart';
+import 'package:harmonoid/core/playback_history.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/mappers/media_player_state.dart';
 import 'package:harmonoid/state/lyrics/lyrics_notifier.dart';
 import 'package:harmonoid/features/now_playing/state/now_playing_color_palette_notifier.dart';
+import 'package:harmonoid/features/now_playing/state/now_playing_waveform_notifier.dart';
 import 'package:harmonoid/features/now_playing/state/now_playing_mobile_notifier.dart';
 import 'package:harmonoid/state/remote_config/models/remote_config_key.dart';
 import 'package:harmonoid/state/remote_config/models/remote_config_value.dart';
@@ -59,10 +63,26 @@ class HarmonoidAppState extends State<HarmonoidApp> with WidgetsBindingObserver
     WidgetsBinding.instance.addObserver(this);
     WidgetsBinding.instance.addPostFrameCallback((_) async {
       final hasInaccessibleDirectories = await MediaLibraryInaccessibleDirectoriesScreen.showIfRequired(context);
+      // NOTE: Without [Configuration.mediaLibraryRefreshUponStart], the media library stays as-is until refreshed manually.
       if (!hasInaccessibleDirectories && Configuration.instance.mediaLibraryRefreshUponStart) {
-        FileSystemMediaLibrary.instance.refresh();
+        // NOTE: Not awaited, so that the playback state is restored meanwhile.
+        if (!await MediaLibraryWatcher.instance.available) {
+          // Seed the journal after a full refresh, subsequent launches only apply deltas.
+          FileSystemMediaLibrary.instance.refresh().then((_) => MediaLibraryWatcher.instance.seed());
+        } else {
+          MediaLibraryWatcher.instance.reconcile();
+        }
       }
-      await Intent.instance.notify(playbackState: Configuration.instance.mediaPlayerPlaybackState);
+      // Extract the color palettes of covers in background, skipping tracks must only perform a lookup.
+      NowPlayingColorPaletteNotifier.instance.precompute();
+      var playbackState = Configuration.instance.mediaPlayerPlaybackState;
+      if (PlaybackQueueJournal.instance.available) {
+        playbackState = playbackState.copyWith(playables: PlaybackQueueJournal.instance.playables, index: PlaybackQueueJournal.instance.index);
+      }
+      await Intent.instance.notify(playbackState: playbackState);
+      // NOTE: Not [MediaPlayer.state]; the player's playlist may not be mapped to it yet (mapped asynchronously, on a separate isolate for
+      //       long queues) & recording an empty queue would splice away the journal.
+      await PlaybackQueueJournal.instance.start(playbackState.playables, playbackState.index);
       // HACK: It is very difficult to pass the entry point arguments to main like other platforms.
       //       This must be done after the [Player] instance inside [MediaPlayer] is initialized.
       if (Platform.isMacOS) {
@@ -103,7 +123,10 @@ class HarmonoidAppState extends State<HarmonoidApp> with WidgetsBindingObserver
     super.didChangeAppLifecycleState(state);
     if (!Platform.isAndroid && !Platform.isIOS) return;
     if (state == AppLifecycleState.paused || state == AppLifecycleState.detached) {
-      Configuration.instance.set(mediaPlayerPlaybackState: MediaPlayer.instance.state.toPlaybackState());
+      // NOTE: The process may be killed while in background, write the pending values immediately.
+      Configuration.instance.set(mediaPlayerPlaybackState: MediaPlayer.instance.state.toPlaybackState()).then((_) => Configuration.instance.flush());
+      PlaybackHistory.instance.flush();
+      if (LyricsNotifier.initialized) LyricsNotifier.instance.flush();
     }
   }
 
@@ -118,6 +141,7 @@ class HarmonoidAppState extends State<HarmonoidApp> with WidgetsBindingObserver
         ChangeNotifierProvider(create: (context) => ThemeNotifier.instance..update(context: context)),
         ChangeNotifierProvider(create: (_) => LyricsNotifier.instance),
         ChangeNotifierProvider(create: (_) => NowPlayingColorPaletteNotifier.instance),
+        ChangeNotifierProvider(create: (_) => NowPlayingWaveformNotifier.instance),
         Provider(create: (_) => NowPlayingMobileNotifier.instance),
         ChangeNotifierProvider(create: (_) => UpdateNotifier(showUpdate: () => showUpdate(context))),
         ChangeNotifierProvider(
@@ -90,6 +90,7 @@ class _AlbumScreenState extends State<AlbumScreen> {
         Icons.shuffle: (_, _) => _tracksMenuProvider.shuffle(_tracks),
         Icons.playlist_play: (_, _) => _tracksMenuProvider.playNext(_tracks),
         Icons.playlist_add_check: (_, _) => _tracksMenuProvider.addToNowPlaying(_tracks),
+        Icons.label: (_, _) => _tracksMenuProvider.editTags(_tracks),
         Icons.delete: (_, _) => _tracksMenuProvider.delete(_tracks),
       },
       labels: {
@@ -97,6 +98,7 @@ class _AlbumScreenState extends State<AlbumScreen> {
         Icons.shuffle: Localization.instance.SHUFFLE,
         Icons.playlist_play: Localization.instance.PLAY_NEXT,
         Icons.playlist_add_check: Localization.instance.ADD_TO_NOW_PLAYING,
+        Icons.label: Localization.instance.EDIT_TAGS,
         Icons.delete: Localization.instance.DELETE,
       },
       tabs: [''],
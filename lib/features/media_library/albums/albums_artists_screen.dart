@@ -1,9 +1,10 @@
 import 'package:adaptive_layouts/adaptive_layouts.dart';
 import 'package:collection/collection.dart';
 import 'package:flutter/material.dart';
-import 'package:media_library/media_library.dart';
+import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
 import 'package:provider/provider.dart';
 
+import 'package:harmonoid/core/filesystem_media_library.dart';
 import 'package:harmonoid/core/media_player/media_player.dart';
 import 'package:harmonoid/extensions/album.dart';
 import 'package:harmonoid/mappers/track.dart';
@@ -55,8 +56,14 @@ class DesktopAlbumsArtistsScreenState extends State<DesktopAlbumsArtistsScreen>
       builder: (context, _) {
         return Scaffold(
           resizeToAvoidBottomInset: false,
-          body: Consumer<MediaLibrary>(
-            builder: (context, mediaLibrary, _) {
+          body: Selector<FileSystemMediaLibrary, (int, AlbumSortType, bool)>(
+            selector: (_, mediaLibrary) => (
+              mediaLibrary.generation(MediaLibraryCollection.albums),
+              mediaLibrary.albumSortType,
+              mediaLibrary.albumSortAscending,
+            ),
+            builder: (context, _, __) {
+              final mediaLibrary = context.read<FileSystemMediaLibrary>();
               final albumArtists = mediaLibrary.albumArtists.entries.toList();
               final scrollViewBuilderHelperData = MediaLibraryScrollViewBuilderDataProvider(context).album;
               return KeyedSubtree(
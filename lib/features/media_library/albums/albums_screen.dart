@@ -1,8 +1,9 @@
 import 'package:adaptive_layouts/adaptive_layouts.dart';
 import 'package:flutter/material.dart';
-import 'package:media_library/media_library.dart';
+import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
 import 'package:provider/provider.dart';
 
+import 'package:harmonoid/core/filesystem_media_library.dart';
 import 'package:harmonoid/extensions/album.dart';
 import 'package:harmonoid/features/media_library/desktop/desktop_media_library_header.dart';
 import 'package:harmonoid/features/media_library/albums/album_item.dart';
@@ -52,8 +53,14 @@ class AlbumsScreenState extends State<AlbumsScreen> {
       builder: (context, _) {
         return Scaffold(
           resizeToAvoidBottomInset: false,
-          body: Consumer<MediaLibrary>(
-            builder: (context, mediaLibrary, _) {
+          body: Selector<FileSystemMediaLibrary, (int, AlbumSortType, bool)>(
+            selector: (_, mediaLibrary) => (
+              mediaLibrary.generation(MediaLibraryCollection.albums),
+              mediaLibrary.albumSortType,
+              mediaLibrary.albumSortAscending,
+            ),
+            builder: (context, _, __) {
+              final mediaLibrary = context.read<FileSystemMediaLibrary>();
               if (mediaLibrary.albumSortType == AlbumSortType.albumArtist) {
                 return const AlbumsArtistsScreen();
               }
@@ -5,7 +5,7 @@ import 'package:provider/provider.dart';
 
 import 'package:harmonoid/features/media_library/artists/state/artist_image_notifier.dart';
 
-class ArtistImage extends StatelessWidget {
+class ArtistImage extends StatefulWidget {
   final Artist artist;
   final int? cacheWidth;
   const ArtistImage({
@@ -14,6 +14,35 @@ class ArtistImage extends StatelessWidget {
     this.cacheWidth,
   });
 
+  @override
+  State<ArtistImage> createState() => _ArtistImageState();
+}
+
+class _ArtistImageState extends State<ArtistImage> {
+  // NOTE: Kept, since the [Provider] cannot be looked up in [dispose].
+  late final ArtistImageNotifier _notifier = context.read<ArtistImageNotifier>();
+
+  @override
+  void initState() {
+    super.initState();
+    _notifier.retain(widget.artist);
+  }
+
+  @override
+  void didUpdateWidget(covariant ArtistImage oldWidget) {
+    super.didUpdateWidget(oldWidget);
+    if (oldWidget.artist != widget.artist) {
+      _notifier.release(oldWidget.artist);
+      _notifier.retain(widget.artist);
+    }
+  }
+
+  @override
+  void dispose() {
+    _notifier.release(widget.artist);
+    super.dispose();
+  }
+
   @override
   Widget build(BuildContext context) {
     return Consumer<ArtistImageNotifier>(
@@ -21,8 +50,8 @@ class ArtistImage extends StatelessWidget {
         return Image(
           key: notifier.key,
           image: cover(
-            item: artist,
-            cacheWidth: cacheWidth,
+            item: widget.artist,
+            cacheWidth: widget.cacheWidth,
           ),
           fit: BoxFit.cover,
           gaplessPlayback: true,
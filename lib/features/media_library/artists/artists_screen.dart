@@ -1,8 +1,9 @@
 import 'package:adaptive_layouts/adaptive_layouts.dart';
 import 'package:flutter/material.dart';
-import 'package:media_library/media_library.dart';
+import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
 import 'package:provider/provider.dart';
 
+import 'package:harmonoid/core/filesystem_media_library.dart';
 import 'package:harmonoid/extensions/artist.dart';
 import 'package:harmonoid/features/media_library/artists/artist_item.dart';
 import 'package:harmonoid/features/media_library/desktop/desktop_media_library_header.dart';
@@ -51,8 +52,14 @@ class ArtistsScreenState extends State<ArtistsScreen> {
       builder: (context, _) {
         return Scaffold(
           resizeToAvoidBottomInset: false,
-          body: Consumer<MediaLibrary>(
-            builder: (context, mediaLibrary, _) {
+          body: Selector<FileSystemMediaLibrary, (int, ArtistSortType, bool)>(
+            selector: (_, mediaLibrary) => (
+              mediaLibrary.generation(MediaLibraryCollection.artists),
+              mediaLibrary.artistSortType,
+              mediaLibrary.artistSortAscending,
+            ),
+            builder: (context, _, __) {
+              final mediaLibrary = context.read<FileSystemMediaLibrary>();
               final scrollViewBuilderHelperData = MediaLibraryScrollViewBuilderDataProvider(context).artist;
 
               return KeyedSubtree(
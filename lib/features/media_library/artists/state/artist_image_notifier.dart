@@ -1,13 +1,14 @@
 import 'dart:async';
+import 'dart:collection';
 import 'dart:convert';
 import 'dart:io';
+import 'dart:isolate';
 
 import 'package:crypto/crypto.dart';
 import 'package:flutter/foundation.dart';
 import 'package:flutter/services.dart';
 import 'package:media_library/media_library.dart';
 import 'package:path/path.dart';
-import 'package:pool/pool.dart';
 import 'package:safe_local_storage/file_system.dart';
 import 'package:synchronized/synchronized.dart';
 
@@ -21,11 +22,31 @@ import 'package:harmonoid/state/remote_config/remote_config_provider.dart';
 import 'package:harmonoid/utils/async_file_image.dart';
 import 'package:harmonoid/utils/debouncer.dart';
 
+/// {@template artist_image_notifier}
+///
+/// ArtistImageNotifier
+/// -------------------
+/// Implementation to resolve, download & customize artist images.
+///
+/// The presence of custom, remote & deleted images is indexed in memory once, so that resolving an image does not touch the file system.
+/// Missing images are downloaded by at most [kConcurrency] workers. Requests are collected for [kDispatchDelay] before being dispatched &
+/// the most recently requested artists are downloaded first, preferring the ones currently visible (see [retain]). Requests of artists
+/// which are no longer visible are cancelled, so scrolling quickly through a large list does not issue a download for every artist.
+///
+/// {@endtemplate}
 class ArtistImageNotifier extends ChangeNotifier {
   static const String kDefaultAssetKey = 'assets/images/default_artist.jpg';
   static const String kDefaultFileName = 'Artist.JPG';
   static const int kDefaultRemoteVersion = 1;
 
+  /// Maximum number of concurrent downloads.
+  static const int kConcurrency = 4;
+
+  /// Duration for which requests are collected before being dispatched.
+  static const Duration kDispatchDelay = Duration(milliseconds: 250);
+
+  /// {@macro artist_image_notifier}
+
   ArtistImageNotifier() {
     _initialization = _initialize();
   }
@@ -42,26 +63,50 @@ class ArtistImageNotifier extends ChangeNotifier {
     await _initialization;
 
     final query = _artistToQuery(artist);
-    final customFile = _queryToCustomFile(query);
-    final remoteFile = _queryToRemoteFile(query);
-    final deletedFile = _queryToDeletedFile(query);
+    final name = _queryToName(query);
 
-    if (await deletedFile.exists_()) {
+    if (_deleted.contains(name)) {
       return null;
     }
 
-    if (await customFile.exists_()) {
-      return customFile;
+    if (_custom.contains(name)) {
+      return _queryToCustomFile(query);
+    }
+
+    if (_remote.contains(name)) {
+      return _queryToRemoteFile(query);
     }
 
-    if (await remoteFile.exists_()) {
-      return await remoteFile.length_() > 0 ? remoteFile : null;
+    if (_missing.contains(name)) {
+      return null;
     }
 
-    unawaited(_download(artist));
+    _request(query, artist);
     return null;
   }
 
+  /// Marks [artist] as visible; visible artists are downloaded first. Must be balanced with [release].
+  void retain(Artist artist) {
+    final query = _artistToQuery(artist);
+    _visible[query] = (_visible[query] ?? 0) + 1;
+    // NOTE: Re-request, since the previous request may have been cancelled when the artist scrolled out of view.
+    if (_initialized && Configuration.instance.mediaLibraryArtistImages && artist.artist != kDefaultArtist && !_indexed(query)) {
+      _request(query, artist);
+    }
+  }
+
+  /// Marks [artist] as no longer visible; its pending download is cancelled.
+  void release(Artist artist) {
+    final query = _artistToQuery(artist);
+    final count = (_visible[query] ?? 0) - 1;
+    if (count > 0) {
+      _visible[query] = count;
+    } else {
+      _visible.remove(query);
+      _pending.remove(query);
+    }
+  }
+
   Future<void> setFile(Artist artist, File value) async {
     await _initialization;
 
@@ -72,6 +117,8 @@ class ArtistImageNotifier extends ChangeNotifier {
       await customFile.delete_();
       await deletedFile.delete_();
       await value.copy_(customFile.path);
+      _custom.add(_queryToName(query));
+      _deleted.remove(_queryToName(query));
       _reset(artist);
     });
   }
@@ -87,6 +134,10 @@ class ArtistImageNotifier extends ChangeNotifier {
       await customFile.delete_();
       await remoteFile.delete_();
       await deletedFile.create_();
+      _custom.remove(_queryToName(query));
+      _remote.remove(_queryToName(query));
+      _missing.remove(_queryToName(query));
+      _deleted.add(_queryToName(query));
       _reset(artist);
     });
   }
@@ -123,7 +174,9 @@ class ArtistImageNotifier extends ChangeNotifier {
 
   @override
   void dispose() {
-    _pool.close();
+    _disposed = true;
+    _pending.clear();
+    _dispatchTimer?.cancel();
     super.dispose();
   }
 
@@ -136,9 +189,25 @@ class ArtistImageNotifier extends ChangeNotifier {
     await _partDirectory.create_();
     await _migrateIfRequired();
     await _initializeRemoteVersion();
+    await _initializeIndex();
+    _initialized = true;
     unawaited(_refreshRemoteVersion());
   }
 
+  Future<void> _initializeIndex() async {
+    try {
+      final (custom, remote, missing, deleted) = await _scan(_customDirectory.path, _remoteVersionDirectory.path, _deletedDirectory.path);
+      _custom.addAll(custom);
+      _remote.addAll(remote);
+      _missing.addAll(missing);
+      _deleted.addAll(deleted);
+      debugPrint('ArtistImageNotifier: _initializeIndex: Custom: ${_custom.length}, Remote: ${_remote.length}, Missing: ${_missing.length}, Deleted: ${_deleted.length}');
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+    }
+  }
+
   Future<void> _initializeRemoteVersion() async {
     final cached = await RemoteConfigProvider().getCached(RemoteConfigKey.artistImageCacheVersion);
     if (cached case ArtistImageCacheVersion()) {
@@ -157,6 +226,8 @@ class ArtistImageNotifier extends ChangeNotifier {
         _remoteVersion = value;
         await _remoteDirectory.delete_();
         await _remoteVersionDirectory.create_();
+        _remote.clear();
+        _missing.clear();
         AsyncFileImage.clear();
         notifyListeners();
       }
@@ -194,48 +265,78 @@ class ArtistImageNotifier extends ChangeNotifier {
     }
   }
 
+  void _request(String query, Artist artist) {
+    if (_disposed || _downloading.contains(query)) return;
+    // Most recently requested last.
+    _pending.remove(query);
+    _pending[query] = artist;
+    _dispatchTimer ??= Timer(kDispatchDelay, _dispatch);
+  }
+
+  void _dispatch() {
+    _dispatchTimer = null;
+    while (_workers < kConcurrency && _pending.isNotEmpty) {
+      _workers++;
+      _work().whenComplete(() => _workers--);
+    }
+  }
+
+  Future<void> _work() async {
+    while (!_disposed && _pending.isNotEmpty) {
+      final query = _pending.keys.lastWhere((e) => _visible.containsKey(e), orElse: () => _pending.keys.last);
+      final artist = _pending.remove(query)!;
+      _downloading.add(query);
+      try {
+        await _download(artist);
+      } finally {
+        _downloading.remove(query);
+      }
+    }
+  }
+
   Future<void> _download(Artist artist, {bool refresh = false}) async {
     final query = _artistToQuery(artist);
+    final name = _queryToName(query);
     try {
       await _queryToLock(query).synchronized(() async {
-        await _pool.withResource(() async {
-          final customFile = _queryToCustomFile(query);
-          final remoteFile = _queryToRemoteFile(query);
-          final deletedFile = _queryToDeletedFile(query);
-          final partFile = _queryToPartFile(query);
-
-          if (refresh) {
-            await customFile.delete_();
-            await remoteFile.delete_();
-            await deletedFile.delete_();
-          } else {
-            if (await deletedFile.exists_()) return;
+        final customFile = _queryToCustomFile(query);
+        final remoteFile = _queryToRemoteFile(query);
+        final deletedFile = _queryToDeletedFile(query);
+        final partFile = _queryToPartFile(query);
+
+        if (refresh) {
+          await customFile.delete_();
+          await remoteFile.delete_();
+          await deletedFile.delete_();
+          _custom.remove(name);
+          _remote.remove(name);
+          _missing.remove(name);
+          _deleted.remove(name);
+        } else {
+          if (_indexed(query)) return;
+        }
 
-            if (await customFile.exists_()) return;
+        if (await partFile.exists_()) {
+          await partFile.delete_();
+        }
 
-            if (await remoteFile.exists_()) return;
+        try {
+          if (await ArtistImageGet().call(query, partFile)) {
+            if (await partFile.exists_()) {
+              await partFile.rename(remoteFile.path);
+              _remote.add(name);
+              _reset(artist);
+            }
+          } else {
+            // Create an empty file to prevent repeated attempts.
+            await remoteFile.create_();
+            _missing.add(name);
           }
-
+        } finally {
           if (await partFile.exists_()) {
             await partFile.delete_();
           }
-
-          try {
-            if (await ArtistImageGet().call(query, partFile)) {
-              if (await partFile.exists_()) {
-                await partFile.rename(remoteFile.path);
-                _reset(artist);
-              }
-            } else {
-              // Create an empty file to prevent repeated attempts.
-              await remoteFile.create_();
-            }
-          } finally {
-            if (await partFile.exists_()) {
-              await partFile.delete_();
-            }
-          }
-        });
+        }
       });
     } catch (exception, stacktrace) {
       debugPrint(exception.toString());
@@ -243,6 +344,33 @@ class ArtistImageNotifier extends ChangeNotifier {
     }
   }
 
+  /// Returns whether the presence of an image (or its absence) is known for [query].
+  bool _indexed(String query) {
+    final name = _queryToName(query);
+    return _deleted.contains(name) || _custom.contains(name) || _remote.contains(name) || _missing.contains(name);
+  }
+
+  // NOTE: Static, so that the closure sent to the isolate only captures the arguments.
+
+  /// Lists the custom, remote (non-empty & empty) & deleted images by name.
+  static Future<(Set<String>, Set<String>, Set<String>, Set<String>)> _scan(String custom, String remote, String deleted) {
+    return Isolate.run(() {
+      List<File> files(String path) {
+        final directory = Directory(path);
+        if (!directory.existsSync()) return [];
+        return directory.listSync(followLinks: false).whereType<File>().toList();
+      }
+
+      final remoteFiles = files(remote).map((e) => (basenameWithoutExtension(e.path), e.statSync().size)).toList();
+      return (
+        files(custom).map((e) => basenameWithoutExtension(e.path)).toSet(),
+        remoteFiles.where((e) => e.$2 > 0).map((e) => e.$1).toSet(),
+        remoteFiles.where((e) => e.$2 == 0).map((e) => e.$1).toSet(),
+        files(deleted).map((e) => basenameWithoutExtension(e.path)).toSet(),
+      );
+    });
+  }
+
   void _reset(Artist artist) {
     AsyncFileImage.reset(artist.toImageKey());
     notifyListeners();
@@ -260,7 +388,9 @@ class ArtistImageNotifier extends ChangeNotifier {
 
   Lock _queryToLock(String query) => _locks.putIfAbsent(query, Lock.new);
 
-  String _queryToFileName(String query, String extension) => '${sha256.convert(utf8.encode(query))}.$extension';
+  String _queryToFileName(String query, String extension) => '${_queryToName(query)}.$extension';
+
+  String _queryToName(String query) => _names[query] ??= sha256.convert(utf8.encode(query)).toString();
 
   Directory get _customDirectory => Directory(join(_directory.path, 'Custom'));
 
@@ -279,6 +409,36 @@ class ArtistImageNotifier extends ChangeNotifier {
   DateTime _notifyListenersTimestamp = DateTime.now();
   final Debouncer _debouncer = Debouncer(timeout: const Duration(seconds: 5));
   final Map<String, Lock> _locks = {};
-  final Pool _pool = Pool(10, timeout: const Duration(seconds: 30));
+
+  /// File name (without extension) by query.
+  final HashMap<String, String> _names = HashMap<String, String>();
+
+  /// Names of the custom images.
+  final HashSet<String> _custom = HashSet<String>();
+
+  /// Names of the downloaded images.
+  final HashSet<String> _remote = HashSet<String>();
+
+  /// Names of the images not available remotely.
+  final HashSet<String> _missing = HashSet<String>();
+
+  /// Names of the images removed by the user.
+  final HashSet<String> _deleted = HashSet<String>();
+
+  /// Number of visible widgets by query.
+  final HashMap<String, int> _visible = HashMap<String, int>();
+
+  /// Artists pending to be downloaded by query; most recently requested last.
+  final LinkedHashMap<String, Artist> _pending = LinkedHashMap<String, Artist>();
+
+  /// Queries being downloaded.
+  final HashSet<String> _downloading = HashSet<String>();
+
+  /// Number of running download workers.
+  int _workers = 0;
+
+  Timer? _dispatchTimer;
+  bool _initialized = false;
+  bool _disposed = false;
   final Directory _directory = Directory(join(Configuration.instance.directory.path, 'ArtistImages'));
 }
@@ -40,7 +40,8 @@ class DesktopMediaLibraryHeaderState extends State<DesktopMediaLibraryHeader> {
           child: InkWell(
             borderRadius: BorderRadius.circular(4.0),
             onTap: () {
-              MediaPlayer.instance.open(context.read<MediaLibrary>().tracks.map((e) => e.toPlayable()));
+              // Same order as the tracks tab.
+              MediaPlayer.instance.open(tracksNotifier.tracks(context.read<MediaLibrary>().tracks).map((e) => e.toPlayable()));
             },
             child: Container(
               height: 44.0,
@@ -68,7 +69,7 @@ class DesktopMediaLibraryHeaderState extends State<DesktopMediaLibraryHeader> {
           child: InkWell(
             borderRadius: BorderRadius.circular(4.0),
             onTap: () {
-              MediaPlayer.instance.open(context.read<MediaLibrary>().tracks.map((e) => e.toPlayable()), shuffle: true);
+              MediaPlayer.instance.open(tracksNotifier.tracks(context.read<MediaLibrary>().tracks).map((e) => e.toPlayable()), shuffle: true);
             },
             child: Container(
               height: 44.0,
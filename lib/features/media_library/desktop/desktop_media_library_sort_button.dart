@@ -7,6 +7,7 @@ import 'package:harmonoid/core/configuration/configuration.dart';
 import 'package:harmonoid/extensions/build_context.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/features/media_library/folders/state/file_explorer_notifier.dart';
+import 'package:harmonoid/features/media_library/tracks/state/tracks_notifier.dart';
 import 'package:harmonoid/routing/utils/constants.dart';
 import 'package:harmonoid/utils/rendering.dart';
 
@@ -66,8 +67,8 @@ class DesktopMediaLibrarySortButtonState extends State<DesktopMediaLibrarySortBu
   @override
   Widget build(BuildContext context) {
     final path = context.location.split('/').last;
-    return Consumer2<MediaLibrary, FileExplorerNotifier>(
-      builder: (context, mediaLibrary, fileExplorerNotifier, _) => Row(
+    return Consumer3<MediaLibrary, FileExplorerNotifier, TracksNotifier>(
+      builder: (context, mediaLibrary, fileExplorerNotifier, tracksNotifier, _) => Row(
         mainAxisSize: MainAxisSize.min,
         mainAxisAlignment: MainAxisAlignment.center,
         crossAxisAlignment: CrossAxisAlignment.center,
@@ -103,12 +104,9 @@ class DesktopMediaLibrarySortButtonState extends State<DesktopMediaLibrarySortBu
                   TrackSortType.values
                       .map(
                         (e) => MenuItemButton(
-                          onPressed: () async {
-                            await mediaLibrary.populate(trackSortType: e);
-                            await Configuration.instance.set(mediaLibraryTrackSortType: e);
-                          },
+                          onPressed: () => tracksNotifier.setSortType(e),
                           style: _menuItemStyle,
-                          leadingIcon: _buildLeadingIcon(mediaLibrary.trackSortType == e),
+                          leadingIcon: _buildLeadingIcon(tracksNotifier.sortType == e),
                           child: Text(
                             switch (e) {
                               TrackSortType.title => Localization.instance.A_TO_Z,
@@ -215,7 +213,7 @@ class DesktopMediaLibrarySortButtonState extends State<DesktopMediaLibrarySortBu
                                     AlbumSortType.year => Localization.instance.YEAR,
                                     AlbumSortType.albumArtist => Localization.instance.ALBUM_ARTIST,
                                   },
-                                  kTracksPath => switch (mediaLibrary.trackSortType) {
+                                  kTracksPath => switch (tracksNotifier.sortType) {
                                     TrackSortType.title => Localization.instance.A_TO_Z,
                                     TrackSortType.timestamp => Localization.instance.DATE_ADDED,
                                     TrackSortType.year => Localization.instance.YEAR,
@@ -265,20 +263,21 @@ class DesktopMediaLibrarySortButtonState extends State<DesktopMediaLibrarySortBu
                         fileExplorerNotifier.setSortAscending(true);
                         return;
                       }
+                      if (path == kTracksPath) {
+                        tracksNotifier.setSortAscending(true);
+                        return;
+                      }
 
                       final albumSortAscending = path == kAlbumsPath ? true : null;
-                      final trackSortAscending = path == kTracksPath ? true : null;
                       final artistSortAscending = path == kArtistsPath ? true : null;
                       final genreSortAscending = path == kGenresPath ? true : null;
                       await mediaLibrary.populate(
                         albumSortAscending: albumSortAscending,
-                        trackSortAscending: trackSortAscending,
                         artistSortAscending: artistSortAscending,
                         genreSortAscending: genreSortAscending,
                       );
                       await Configuration.instance.set(
                         mediaLibraryAlbumSortAscending: albumSortAscending,
-                        mediaLibraryTrackSortAscending: trackSortAscending,
                         mediaLibraryArtistSortAscending: artistSortAscending,
                         mediaLibraryGenreSortAscending: genreSortAscending,
                       );
@@ -287,7 +286,7 @@ class DesktopMediaLibrarySortButtonState extends State<DesktopMediaLibrarySortBu
                     leadingIcon: _buildLeadingIcon(
                       switch (path) {
                         kAlbumsPath => mediaLibrary.albumSortAscending,
-                        kTracksPath => mediaLibrary.trackSortAscending,
+                        kTracksPath => tracksNotifier.sortAscending,
                         kArtistsPath => mediaLibrary.artistSortAscending,
                         kGenresPath => mediaLibrary.genreSortAscending,
                         kFoldersPath => fileExplorerNotifier.sortAscending,
@@ -307,20 +306,21 @@ class DesktopMediaLibrarySortButtonState extends State<DesktopMediaLibrarySortBu
                         fileExplorerNotifier.setSortAscending(false);
                         return;
                       }
+                      if (path == kTracksPath) {
+                        tracksNotifier.setSortAscending(false);
+                        return;
+                      }
 
                       final albumSortAscending = path == kAlbumsPath ? false : null;
-                      final trackSortAscending = path == kTracksPath ? false : null;
                       final artistSortAscending = path == kArtistsPath ? false : null;
                       final genreSortAscending = path == kGenresPath ? false : null;
                       await mediaLibrary.populate(
                         albumSortAscending: albumSortAscending,
-                        trackSortAscending: trackSortAscending,
                         artistSortAscending: artistSortAscending,
                         genreSortAscending: genreSortAscending,
                       );
                       await Configuration.instance.set(
                         mediaLibraryAlbumSortAscending: albumSortAscending,
-                        mediaLibraryTrackSortAscending: trackSortAscending,
                         mediaLibraryArtistSortAscending: artistSortAscending,
                         mediaLibraryGenreSortAscending: genreSortAscending,
                       );
@@ -329,7 +329,7 @@ class DesktopMediaLibrarySortButtonState extends State<DesktopMediaLibrarySortBu
                     leadingIcon: _buildLeadingIcon(
                       !switch (path) {
                         kAlbumsPath => mediaLibrary.albumSortAscending,
-                        kTracksPath => mediaLibrary.trackSortAscending,
+                        kTracksPath => tracksNotifier.sortAscending,
                         kArtistsPath => mediaLibrary.artistSortAscending,
                         kGenresPath => mediaLibrary.genreSortAscending,
                         kFoldersPath => fileExplorerNotifier.sortAscending,
@@ -376,7 +376,7 @@ class DesktopMediaLibrarySortButtonState extends State<DesktopMediaLibrarySortBu
                                   text:
                                       switch (path) {
                                         kAlbumsPath => mediaLibrary.albumSortAscending,
-                                        kTracksPath => mediaLibrary.trackSortAscending,
+                                        kTracksPath => tracksNotifier.sortAscending,
                                         kArtistsPath => mediaLibrary.artistSortAscending,
                                         kGenresPath => mediaLibrary.genreSortAscending,
                                         kFoldersPath => fileExplorerNotifier.sortAscending,
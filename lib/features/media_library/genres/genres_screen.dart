@@ -1,8 +1,9 @@
 import 'package:adaptive_layouts/adaptive_layouts.dart';
 import 'package:flutter/material.dart';
-import 'package:media_library/media_library.dart';
+import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
 import 'package:provider/provider.dart';
 
+import 'package:harmonoid/core/filesystem_media_library.dart';
 import 'package:harmonoid/extensions/genre.dart';
 import 'package:harmonoid/features/media_library/desktop/desktop_media_library_header.dart';
 import 'package:harmonoid/features/media_library/genres/genre_item.dart';
@@ -51,8 +52,14 @@ class GenresScreenState extends State<GenresScreen> {
       builder: (context, _) {
         return Scaffold(
           resizeToAvoidBottomInset: false,
-          body: Consumer<MediaLibrary>(
-            builder: (context, mediaLibrary, _) {
+          body: Selector<FileSystemMediaLibrary, (int, GenreSortType, bool)>(
+            selector: (_, mediaLibrary) => (
+              mediaLibrary.generation(MediaLibraryCollection.genres),
+              mediaLibrary.genreSortType,
+              mediaLibrary.genreSortAscending,
+            ),
+            builder: (context, _, __) {
+              final mediaLibrary = context.read<FileSystemMediaLibrary>();
               final scrollViewBuilderHelperData = MediaLibraryScrollViewBuilderDataProvider(context).genre;
 
               return KeyedSubtree(
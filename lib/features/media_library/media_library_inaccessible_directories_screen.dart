@@ -7,6 +7,7 @@ import 'package:safe_local_storage/safe_local_storage.dart';
 
 import 'package:harmonoid/core/configuration/configuration.dart';
 import 'package:harmonoid/core/filesystem_media_library.dart';
+import 'package:harmonoid/core/media_library_watcher.dart';
 import 'package:harmonoid/extensions/configuration.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/routing/models/inaccessible_directories_path_extra.dart';
@@ -91,6 +92,7 @@ class _MediaLibraryInaccessibleDirectoriesScreenState extends State<MediaLibrary
     try {
       await Configuration.instance.removeMediaLibraryDirectory(directory);
       await FileSystemMediaLibrary.instance.removeDirectories({directory});
+      MediaLibraryWatcher.instance.reconcile(dirty: {});
 
       await refresh();
 
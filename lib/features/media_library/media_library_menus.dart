@@ -6,9 +6,12 @@ import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
 import 'package:provider/provider.dart';
 import 'package:safe_local_storage/safe_local_storage.dart';
 import 'package:share_plus/share_plus.dart';
+import 'package:taglib/taglib.dart';
 
+import 'package:harmonoid/core/bulk_tag_writer.dart';
 import 'package:harmonoid/core/filesystem_media_library.dart';
 import 'package:harmonoid/core/media_player/media_player.dart';
+import 'package:harmonoid/core/playback_history.dart';
 import 'package:harmonoid/extensions/go_router.dart';
 import 'package:harmonoid/extensions/track.dart';
 import 'package:harmonoid/localization/localization.dart';
@@ -285,6 +288,75 @@ abstract class _BaseTracksMenuProvider {
     await showAddToPlaylistDialog(context, tracks: tracks);
   }
 
+  /// Sets a single property of all [tracks] at once through [BulkTagWriter], e.g. the album artist of a box set.
+  Future<void> editTags(List<Track> tracks) async {
+    if (tracks.isEmpty) return;
+    if (Platform.isAndroid && !await AndroidStorageController.instance.write(tracks.map((e) => File(e.uri)).toList())) return;
+
+    final key = await showSelection<String>(
+      context,
+      Localization.instance.TAG_EDITOR_ADD_PROPERTY,
+      TagLibFile.kProperties,
+      null,
+      (key) => key,
+      actions: false,
+      radio: false,
+    );
+    if (key == null || !context.mounted) return;
+    final value = await showInput(
+      context,
+      Localization.instance.EDIT_TAGS,
+      Localization.instance.TAG_EDITOR_KEY.replaceAll('"KEY"', key),
+      Localization.instance.SAVE,
+      (value) => null,
+    );
+    if (value.isEmpty || !context.mounted) return;
+
+    final navigator = Navigator.of(context, rootNavigator: true);
+    final progress = ValueNotifier<BulkTagWriterProgress?>(null);
+    showDialog(
+      context: context,
+      barrierDismissible: false,
+      builder: (context) => PopScope(
+        canPop: false,
+        child: AlertDialog(
+          title: Text(Localization.instance.EDIT_TAGS),
+          content: ValueListenableBuilder<BulkTagWriterProgress?>(
+            valueListenable: progress,
+            builder: (context, value, _) => Column(
+              mainAxisSize: MainAxisSize.min,
+              crossAxisAlignment: CrossAxisAlignment.stretch,
+              spacing: 16.0,
+              children: [
+                LinearProgressIndicator(value: value == null || value.total == 0 ? null : value.completed / value.total),
+                Text(value == null ? '' : '${value.completed}/${value.total}', style: Theme.of(context).textTheme.bodySmall),
+              ],
+            ),
+          ),
+        ),
+      ),
+    );
+    Object? error;
+    try {
+      await BulkTagWriter.instance.apply(
+        [for (final track in tracks) TagEdit(uri: track.uri, properties: {key: value})],
+        onProgress: (e) => progress.value = e,
+      );
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+      error = exception;
+    } finally {
+      navigator.pop();
+      progress.dispose();
+    }
+    // The selected tracks are re-read, these are no longer part of the media library.
+    mediaLibrarySelectedTracks.value = {};
+    if (error != null && context.mounted) {
+      await showMessage(context, Localization.instance.ERROR, error.toString());
+    }
+  }
+
   Future<void> delete(List<Track> tracks, {Future<bool> Function()? recursivelyPopNavigatorOnDeleteIf}) async {
     if (Platform.isAndroid) {
       final sdk = AndroidStorageController.instance.version;
@@ -330,6 +402,7 @@ enum TracksMenuAction {
   playNext,
   addToNowPlaying,
   addToPlaylist,
+  editTags,
   delete,
 }
 
@@ -359,12 +432,14 @@ class TracksMenuProvider extends _BaseTracksMenuProvider {
       TracksMenuAction.playNext => playNext(tracks),
       TracksMenuAction.addToNowPlaying => addToNowPlaying(tracks),
       TracksMenuAction.addToPlaylist => addToPlaylist(tracks),
+      TracksMenuAction.editTags => editTags(tracks),
       TracksMenuAction.delete => delete(tracks, recursivelyPopNavigatorOnDeleteIf: recursivelyPopNavigatorOnDeleteIf),
     };
   }
 
   bool getVisible(TracksMenuAction action) {
     return switch (action) {
+      TracksMenuAction.editTags => _fileSystemMediaLibrary != null,
       // SDK 29 cannot delete multiple files at once.
       TracksMenuAction.delete => _fileSystemMediaLibrary != null && (!Platform.isAndroid || AndroidStorageController.instance.version != 29),
       _ => true,
@@ -378,6 +453,7 @@ class TracksMenuProvider extends _BaseTracksMenuProvider {
       TracksMenuAction.playNext => Icons.playlist_play,
       TracksMenuAction.addToNowPlaying => Icons.playlist_add_check,
       TracksMenuAction.addToPlaylist => Icons.playlist_add,
+      TracksMenuAction.editTags => Icons.label,
       TracksMenuAction.delete => Icons.delete,
     };
   }
@@ -389,6 +465,7 @@ class TracksMenuProvider extends _BaseTracksMenuProvider {
       TracksMenuAction.playNext => Localization.instance.PLAY_NEXT,
       TracksMenuAction.addToNowPlaying => Localization.instance.ADD_TO_NOW_PLAYING,
       TracksMenuAction.addToPlaylist => Localization.instance.ADD_TO_PLAYLIST,
+      TracksMenuAction.editTags => Localization.instance.EDIT_TAGS,
       TracksMenuAction.delete => Localization.instance.DELETE,
     };
   }
@@ -596,6 +673,9 @@ class PlaylistEntryMenuProvider {
     );
     if (result) {
       await _mediaLibrary.playlists.deleteEntry(playlistEntry);
+      if (playlist == _mediaLibrary.playlists.historyPlaylist) {
+        PlaybackHistory.instance.invalidate();
+      }
     }
   }
 
@@ -9,6 +9,7 @@ import 'package:provider/provider.dart';
 
 import 'package:harmonoid/core/intent.dart';
 import 'package:harmonoid/core/media_player/media_player.dart';
+import 'package:harmonoid/features/media_library/tracks/state/tracks_notifier.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/mappers/track.dart';
 import 'package:harmonoid/routing/utils/constants.dart';
@@ -28,6 +29,7 @@ class MobileMediaLibraryAppBarOverflowButtonState extends State<MobileMediaLibra
       icon: const Icon(Icons.more_vert),
       onPressed: () async {
         final mediaLibrary = context.read<MediaLibrary>();
+        final tracksNotifier = context.read<TracksNotifier>();
         Completer<int> completer = Completer<int>();
         await showModalBottomSheet(
           context: context,
@@ -102,12 +104,13 @@ class MobileMediaLibraryAppBarOverflowButtonState extends State<MobileMediaLibra
           switch (value) {
             case 0:
               {
-                await MediaPlayer.instance.open(mediaLibrary.tracks.map((e) => e.toPlayable()));
+                // Same order as the tracks tab.
+                await MediaPlayer.instance.open(tracksNotifier.tracks(mediaLibrary.tracks).map((e) => e.toPlayable()));
                 break;
               }
             case 1:
               {
-                MediaPlayer.instance.open(mediaLibrary.tracks.map((e) => e.toPlayable()), shuffle: true);
+                MediaPlayer.instance.open(tracksNotifier.tracks(mediaLibrary.tracks).map((e) => e.toPlayable()), shuffle: true);
                 break;
               }
             case 2:
@@ -7,6 +7,7 @@ import 'package:harmonoid/core/configuration/configuration.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/features/media_library/folders/state/file_explorer_notifier.dart';
 import 'package:harmonoid/features/media_library/mobile/mobile_media_library_sort_button_popup_menu_item.dart';
+import 'package:harmonoid/features/media_library/tracks/state/tracks_notifier.dart';
 import 'package:harmonoid/routing/utils/constants.dart';
 import 'package:harmonoid/utils/rendering.dart';
 
@@ -23,14 +24,14 @@ class MobileMediaLibrarySortButtonState extends State<MobileMediaLibrarySortButt
   void Function(void Function())? _setStateCallback;
   late final MediaLibrary _mediaLibrary = context.read<MediaLibrary>();
   late final FileExplorerNotifier _fileExplorerNotifier = context.read<FileExplorerNotifier>();
+  late final TracksNotifier _tracksNotifier = context.read<TracksNotifier>();
 
   Future<void> _handle(dynamic value) async {
     if (value is AlbumSortType) {
       await _mediaLibrary.populate(albumSortType: value);
       await Configuration.instance.set(mediaLibraryAlbumSortType: value);
     } else if (value is TrackSortType) {
-      await _mediaLibrary.populate(trackSortType: value);
-      await Configuration.instance.set(mediaLibraryTrackSortType: value);
+      _tracksNotifier.setSortType(value);
     } else if (value is ArtistSortType) {
       await _mediaLibrary.populate(artistSortType: value);
       await Configuration.instance.set(mediaLibraryArtistSortType: value);
@@ -47,8 +48,7 @@ class MobileMediaLibrarySortButtonState extends State<MobileMediaLibrarySortButt
           await Configuration.instance.set(mediaLibraryAlbumSortAscending: true);
           break;
         case kTracksPath:
-          await _mediaLibrary.populate(trackSortAscending: true);
-          await Configuration.instance.set(mediaLibraryTrackSortAscending: true);
+          _tracksNotifier.setSortAscending(true);
           break;
         case kArtistsPath:
           await _mediaLibrary.populate(artistSortAscending: true);
@@ -69,8 +69,7 @@ class MobileMediaLibrarySortButtonState extends State<MobileMediaLibrarySortButt
           await Configuration.instance.set(mediaLibraryAlbumSortAscending: false);
           break;
         case kTracksPath:
-          await _mediaLibrary.populate(trackSortAscending: false);
-          await Configuration.instance.set(mediaLibraryTrackSortAscending: false);
+          _tracksNotifier.setSortAscending(false);
           break;
         case kArtistsPath:
           await _mediaLibrary.populate(artistSortAscending: false);
@@ -86,6 +85,8 @@ class MobileMediaLibrarySortButtonState extends State<MobileMediaLibrarySortButt
       }
     }
     _setStateCallback?.call(() {});
+    // Update the label.
+    if (mounted) setState(() {});
   }
 
   List<MobileMediaLibrarySortButtonPopupMenuItem> get _sort => {
@@ -112,7 +113,7 @@ class MobileMediaLibrarySortButtonState extends State<MobileMediaLibrarySortButt
         .map(
           (e) => MobileMediaLibrarySortButtonPopupMenuItem(
             onTap: () => _handle(e),
-            checked: _mediaLibrary.trackSortType == e,
+            checked: _tracksNotifier.sortType == e,
             value: e,
             padding: EdgeInsets.zero,
             child: Text(
@@ -184,7 +185,7 @@ class MobileMediaLibrarySortButtonState extends State<MobileMediaLibrarySortButt
       onTap: () => _handle(true),
       checked: switch (widget.path) {
         kAlbumsPath => _mediaLibrary.albumSortAscending,
-        kTracksPath => _mediaLibrary.trackSortAscending,
+        kTracksPath => _tracksNotifier.sortAscending,
         kArtistsPath => _mediaLibrary.artistSortAscending,
         kGenresPath => _mediaLibrary.genreSortAscending,
         kFoldersPath => _fileExplorerNotifier.sortAscending,
@@ -201,7 +202,7 @@ class MobileMediaLibrarySortButtonState extends State<MobileMediaLibrarySortButt
       onTap: () => _handle(false),
       checked: switch (widget.path) {
         kAlbumsPath => !_mediaLibrary.albumSortAscending,
-        kTracksPath => !_mediaLibrary.trackSortAscending,
+        kTracksPath => !_tracksNotifier.sortAscending,
         kArtistsPath => !_mediaLibrary.artistSortAscending,
         kGenresPath => !_mediaLibrary.genreSortAscending,
         kFoldersPath => !_fileExplorerNotifier.sortAscending,
@@ -5,6 +5,7 @@ import 'package:media_library/media_library.dart';
 import 'package:media_library/playlists/src/utils/constants.dart';
 import 'package:provider/provider.dart';
 
+import 'package:harmonoid/core/playback_history.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/features/media_library/media_library_menus.dart';
 import 'package:harmonoid/features/media_library/playlists/playlist_icon.dart';
@@ -23,7 +24,9 @@ class PlaylistItem extends StatefulWidget {
 }
 
 class PlaylistItemState extends State<PlaylistItem> {
-  late final Future<List<PlaylistEntry>> _entries = context.read<MediaLibrary>().playlists.playlistEntries(widget.playlist);
+  late final Future<List<PlaylistEntry>> _entries = widget.playlist == context.read<MediaLibrary>().playlists.historyPlaylist
+      ? PlaybackHistory.instance.entries()
+      : context.read<MediaLibrary>().playlists.playlistEntries(widget.playlist);
 
   Future<void> onSecondaryPress(BuildContext context, {RelativeRect? position}) async {
     final playlistMenuProvider = PlaylistMenuProvider(context, widget.playlist);
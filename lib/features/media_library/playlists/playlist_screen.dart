@@ -5,6 +5,7 @@ import 'package:media_library/playlists/src/utils/constants.dart';
 import 'package:provider/provider.dart';
 
 import 'package:harmonoid/core/media_player/media_player.dart';
+import 'package:harmonoid/core/playback_history.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/mappers/playlist_entry.dart';
 import 'package:harmonoid/core/media_player/models/playable.dart';
@@ -123,7 +124,10 @@ class _PlaylistScreenState extends State<PlaylistScreen> {
           onPopupMenuItemSelected: (context, i, result) async {
             await PlaylistEntryMenuProvider(context, widget.playlist, _entries[i]).handlePopupMenuAction(result);
             // NOTE: The track could've been deleted, so we need to check & update the list.
-            final entries = await context.read<MediaLibrary>().playlists.playlistEntries(widget.playlist);
+            final mediaLibrary = context.read<MediaLibrary>();
+            final entries = widget.playlist == mediaLibrary.playlists.historyPlaylist
+                ? await PlaybackHistory.instance.entries()
+                : await mediaLibrary.playlists.playlistEntries(widget.playlist);
             if (entries.length != _entries.length) {
               setState(() {
                 _entries
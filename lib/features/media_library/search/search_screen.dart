@@ -4,6 +4,7 @@ import 'package:go_router/go_router.dart';
 import 'package:media_library/media_library.dart';
 import 'package:provider/provider.dart';
 
+import 'package:harmonoid/core/media_library_search_index.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/features/media_library/albums/album_item.dart';
 import 'package:harmonoid/features/media_library/artists/artist_item.dart';
@@ -35,48 +36,82 @@ class SearchScreenState extends State<SearchScreen> with ScrollControllerMixin {
   final List<Artist> _artists = <Artist>[];
   final List<Genre> _genres = <Genre>[];
   final List<Track> _tracks = <Track>[];
+  MediaLibrarySearchResult? _result;
 
   String? _currentQuery;
 
   void update(String query) async {
     _currentQuery = query;
-    final result = await context.read<MediaLibrary>().search(
-      query,
-      limit: kLimit,
-    );
+    final result = await search(query, limit: kLimit);
     if (_currentQuery != query) {
       return;
     }
     if (context.mounted) {
       setState(() {
+        _result = result;
         _albums
           ..clear()
-          ..addAll(result.whereType<Album>());
+          ..addAll(result.albums);
         _artists
           ..clear()
-          ..addAll(result.whereType<Artist>());
+          ..addAll(result.artists);
         _genres
           ..clear()
-          ..addAll(result.whereType<Genre>());
+          ..addAll(result.genres);
         _tracks
           ..clear()
-          ..addAll(result.whereType<Track>());
+          ..addAll(result.tracks);
       });
     }
   }
 
+  /// Searches [MediaLibrarySearchIndex]; or [MediaLibrary.search] while the index is not up-to-date (e.g. at startup or during a refresh).
+  Future<MediaLibrarySearchResult> search(String query, {int? limit}) async {
+    if (MediaLibrarySearchIndex.instance.ready) {
+      return MediaLibrarySearchIndex.instance.search(query, limit: limit);
+    }
+    final mediaLibrary = context.read<MediaLibrary>();
+    final result = limit == null ? await mediaLibrary.search(query) : await mediaLibrary.search(query, limit: limit);
+    final albums = result.whereType<Album>().toList();
+    final artists = result.whereType<Artist>().toList();
+    final genres = result.whereType<Genre>().toList();
+    final tracks = result.whereType<Track>().toList();
+    return MediaLibrarySearchResult(
+      albums: albums,
+      artists: artists,
+      genres: genres,
+      tracks: tracks,
+      albumsCount: albums.length,
+      artistsCount: artists.length,
+      genresCount: genres.length,
+      tracksCount: tracks.length,
+    );
+  }
+
+  void _listener() {
+    // Results may have been missing or partial while the index was updating.
+    if (MediaLibrarySearchIndex.instance.ready) {
+      update(widget.query);
+    }
+  }
+
   @override
   void initState() {
     super.initState();
-    _currentQuery = widget.query;
+    MediaLibrarySearchIndex.instance.addListener(_listener);
     update(widget.query);
   }
 
+  @override
+  void dispose() {
+    MediaLibrarySearchIndex.instance.removeListener(_listener);
+    super.dispose();
+  }
+
   @override
   void didUpdateWidget(covariant SearchScreen oldWidget) {
     super.didUpdateWidget(oldWidget);
     if (oldWidget.query != widget.query) {
-      _currentQuery = widget.query;
       update(widget.query);
     }
   }
@@ -101,14 +136,14 @@ class SearchScreenState extends State<SearchScreen> with ScrollControllerMixin {
               children: [
                 SubHeader(Localization.instance.ALBUMS),
                 const Spacer(),
-                if (_albums.length > kLimit)
+                if ((_result?.albumsCount ?? 0) > kLimit)
                   ShowAllButton(
                     onPressed: () async {
                       context.push(
                         '/$kMediaLibraryPath/$kSearchItemsPath',
                         extra: SearchItemsPathExtra(
                           query: widget.query,
-                          items: (await context.read<MediaLibrary>().search(widget.query)).whereType<Album>().toList(),
+                          items: (await search(widget.query)).albums,
                         ),
                       );
                     },
@@ -141,14 +176,14 @@ class SearchScreenState extends State<SearchScreen> with ScrollControllerMixin {
               children: [
                 SubHeader(Localization.instance.ARTISTS),
                 const Spacer(),
-                if (_artists.length > kLimit)
+                if ((_result?.artistsCount ?? 0) > kLimit)
                   ShowAllButton(
                     onPressed: () async {
                       context.push(
                         '/$kMediaLibraryPath/$kSearchItemsPath',
                         extra: SearchItemsPathExtra(
                           query: widget.query,
-                          items: (await context.read<MediaLibrary>().search(widget.query)).whereType<Artist>().toList(),
+                          items: (await search(widget.query)).artists,
                         ),
                       );
                     },
@@ -181,14 +216,14 @@ class SearchScreenState extends State<SearchScreen> with ScrollControllerMixin {
               children: [
                 SubHeader(Localization.instance.GENRES),
                 const Spacer(),
-                if (_genres.length > kLimit)
+                if ((_result?.genresCount ?? 0) > kLimit)
                   ShowAllButton(
                     onPressed: () async {
                       context.push(
                         '/$kMediaLibraryPath/$kSearchItemsPath',
                         extra: SearchItemsPathExtra(
                           query: widget.query,
-                          items: (await context.read<MediaLibrary>().search(widget.query)).whereType<Genre>().toList(),
+                          items: (await search(widget.query)).genres,
                         ),
                       );
                     },
@@ -221,14 +256,14 @@ class SearchScreenState extends State<SearchScreen> with ScrollControllerMixin {
               children: [
                 SubHeader(Localization.instance.TRACKS),
                 const Spacer(),
-                if (_tracks.length > kLimit)
+                if ((_result?.tracksCount ?? 0) > kLimit)
                   ShowAllButton(
                     onPressed: () async {
                       context.push(
                         '/$kMediaLibraryPath/$kSearchItemsPath',
                         extra: SearchItemsPathExtra(
                           query: widget.query,
-                          items: (await context.read<MediaLibrary>().search(widget.query)).whereType<Track>().toList(),
+                          items: (await search(widget.query)).tracks,
                         ),
                       );
                     },
@@ -1,18 +1,14 @@
-import 'dart:io';
 import 'package:collection/collection.dart';
 import 'package:file_picker/file_picker.dart';
 import 'package:flutter/widgets.dart';
 import 'package:http/http.dart' as http;
-import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
 import 'package:safe_local_storage/file_system.dart';
 import 'package:taglib/taglib.dart';
 import 'package:uuid/uuid.dart';
 
-import 'package:harmonoid/core/filesystem_media_library.dart';
+import 'package:harmonoid/core/bulk_tag_writer.dart';
 import 'package:harmonoid/localization/localization.dart';
-import 'package:harmonoid/mappers/media_library_item.dart';
 import 'package:harmonoid/features/media_library/tag_editor/search/models/track_search_result.dart';
-import 'package:harmonoid/utils/async_file_image.dart';
 import 'package:harmonoid/utils/rendering.dart';
 
 class TagEditorNotifier extends ChangeNotifier {
@@ -200,27 +196,35 @@ class TagEditorNotifier extends ChangeNotifier {
       final oldPropertiesMap = _oldPropertiesMap;
       final newPropertiesMap = propertiesMap;
 
+      final properties = <String, String?>{};
       for (final key in oldPropertiesMap.keys) {
         if (!newPropertiesMap.containsKey(key)) {
-          await _tagLibFile.removeProperty(key);
+          properties[key] = null;
           debugPrint('TagEditorNotifier: save: Remove property: $key');
         }
       }
       for (final MapEntry(:key, :value) in newPropertiesMap.entries) {
         if (oldPropertiesMap[key] == value) continue;
-        if (value.isEmpty) {
-          await _tagLibFile.removeProperty(key);
-          debugPrint('TagEditorNotifier: save: Remove property: $key');
-        } else {
-          await _tagLibFile.setProperty(key, [value]);
-          debugPrint('TagEditorNotifier: save: Set property: $key: $value');
-        }
+        properties[key] = value;
+        debugPrint('TagEditorNotifier: save: Set property: $key: $value');
       }
 
-      await _tagLibFile.save();
-
+      // NOTE: The file is written through a temporary copy & renamed over the original, which must not be open.
       await _disposeTagLibFile();
-      await _postProcessResource();
+      try {
+        await BulkTagWriter.instance.apply([
+          TagEdit(
+            uri: resource,
+            properties: properties,
+            cover: coverChanged ? cover : null,
+            removeCover: coverChanged && cover == null,
+          ),
+        ]);
+      } catch (_) {
+        // Keep the pending edits, so that saving can be retried.
+        _tagLibFile = TagLibFile(resource);
+        rethrow;
+      }
       await _initializeTagLibFile();
       propertiesChanged = false;
       coverChanged = false;
@@ -301,32 +305,6 @@ class TagEditorNotifier extends ChangeNotifier {
 
   Future<void> _preProcessResource() async {}
 
-  Future<void> _postProcessResource() async {
-    // Refresh the media library.
-
-    final originalTrack = _fileSystemMediaLibrary.lookupTrack(TrackLookupKey(uri: resource));
-
-    if (originalTrack != null) {
-      AsyncFileImage.reset(originalTrack.toImageKey());
-      await MediaLibrary.trackUriToCoverFile(_fileSystemMediaLibrary.covers, resource).delete_();
-
-      await _fileSystemMediaLibrary.remove([originalTrack], delete: false);
-      await _fileSystemMediaLibrary.add(File(resource));
-      await _fileSystemMediaLibrary.populate();
-    }
-
-    // Refresh the playlists.
-
-    final newTrack = _fileSystemMediaLibrary.lookupTrack(TrackLookupKey(uri: resource));
-
-    if (originalTrack != null && newTrack != null) {
-      await _fileSystemMediaLibrary.playlists.replaceHash(
-        HashEncoder.trackToHash(originalTrack),
-        HashEncoder.trackToHash(newTrack),
-      );
-    }
-  }
-
   Future<void> _initializeTagLibFile() async {
     _tagLibFile = TagLibFile(resource);
 
@@ -344,7 +322,6 @@ class TagEditorNotifier extends ChangeNotifier {
   late TagLibFile _tagLibFile;
   late Map<String, String> _oldPropertiesMap;
   late CoverData? _oldCover;
-  final FileSystemMediaLibrary _fileSystemMediaLibrary = FileSystemMediaLibrary.instance;
 }
 
 extension MapStringStringExtensions<K, V> on Map<K, V> {
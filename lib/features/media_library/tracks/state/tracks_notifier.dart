@@ -1,12 +1,30 @@
 import 'package:flutter/widgets.dart';
+import 'package:media_library/media_library.dart';
 
 import 'package:harmonoid/core/configuration/configuration.dart';
+import 'package:harmonoid/core/track_sort_index.dart';
 import 'package:harmonoid/features/media_library/tracks/models/track_view_type.dart';
 
 class TracksNotifier extends ChangeNotifier {
-  TracksNotifier();
+  TracksNotifier() {
+    TrackSortIndex.instance.addListener(notifyListeners);
+  }
 
   TrackViewType viewType = Configuration.instance.mediaLibraryTrackViewType;
+  TrackSortType sortType = Configuration.instance.mediaLibraryTrackSortType;
+  bool sortAscending = Configuration.instance.mediaLibraryTrackSortAscending;
+
+  /// Returns the tracks in the current [sortType] & [sortAscending] order; [fallback] sorted in the same order if [TrackSortIndex] is not
+  /// ready yet.
+  List<Track> tracks(List<Track> fallback) {
+    final result = TrackSortIndex.instance.sorted(sortType, sortAscending);
+    if (result != null) return result;
+    final cached = _fallback;
+    if (cached != null && identical(cached.$1, fallback) && cached.$2 == sortType && cached.$3 == sortAscending) return cached.$4;
+    final value = TrackSortIndex.sort(fallback, sortType, sortAscending);
+    _fallback = (fallback, sortType, sortAscending, value);
+    return value;
+  }
 
   void setViewType(TrackViewType value) {
     viewType = value;
@@ -17,4 +35,25 @@ class TracksNotifier extends ChangeNotifier {
   void toggleViewType() {
     setViewType(TrackViewType.values[(viewType.index + 1) % TrackViewType.values.length]);
   }
+
+  void setSortType(TrackSortType value) {
+    sortType = value;
+    notifyListeners();
+    Configuration.instance.set(mediaLibraryTrackSortType: value);
+  }
+
+  void setSortAscending(bool value) {
+    sortAscending = value;
+    notifyListeners();
+    Configuration.instance.set(mediaLibraryTrackSortAscending: value);
+  }
+
+  @override
+  void dispose() {
+    TrackSortIndex.instance.removeListener(notifyListeners);
+    super.dispose();
+  }
+
+  /// [tracks] sorted by [sortType] & [sortAscending] until [TrackSortIndex] is ready; along with the list & order it was sorted from.
+  (List<Track>, TrackSortType, bool, List<Track>)? _fallback;
 }
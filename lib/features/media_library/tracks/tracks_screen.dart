@@ -54,12 +54,13 @@ class TracksScreenState extends State<TracksScreen> {
       resizeToAvoidBottomInset: true,
       body: Consumer2<MediaLibrary, TracksNotifier>(
         builder: (context, mediaLibrary, tracksNotifier, _) {
+          final tracks = tracksNotifier.tracks(mediaLibrary.tracks);
           return KeyedSubtree(
-            key: ValueKey((mediaLibrary.trackSortType, mediaLibrary.trackSortAscending, mediaLibrary.tracks.length, tracksNotifier.viewType)),
+            key: ValueKey((tracksNotifier.sortType, tracksNotifier.sortAscending, tracks.length, tracksNotifier.viewType)),
             child: switch (tracksNotifier.viewType) {
               TrackViewType.list => TracksTable(
                 key: const PageStorageKey(TracksScreen),
-                tracks: mediaLibrary.tracks,
+                tracks: tracks,
                 headerBuilder: _buildHeader,
                 desktopOnColumnResize: (widths) {
                   _desktopColumnWidthsDebouncer.run(() {
@@ -70,7 +71,7 @@ class TracksScreenState extends State<TracksScreen> {
               ),
               TrackViewType.grid => TracksGrid(
                 key: const PageStorageKey(TracksScreen),
-                tracks: mediaLibrary.tracks,
+                tracks: tracks,
               ),
             },
           );
@@ -15,6 +15,7 @@ import 'package:harmonoid/extensions/string.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/core/media_player/models/loop.dart';
 import 'package:harmonoid/features/now_playing/state/now_playing_color_palette_notifier.dart';
+import 'package:harmonoid/features/now_playing/state/now_playing_waveform_notifier.dart';
 import 'package:harmonoid/features/media_library/utils/rendering.dart';
 import 'package:harmonoid/features/media_library/playlists/utils/rendering.dart';
 import 'package:harmonoid/features/media_library/utils/constants.dart';
@@ -386,6 +387,7 @@ class Controls extends StatelessWidget {
                         value: sliderValue,
                         onChanged: (value) => mediaPlayer.seek(Duration(milliseconds: value.round())),
                         paused: !mediaPlayer.state.playing,
+                        peaks: context.watch<NowPlayingWaveformNotifier>().peaks,
                       ),
                     ),
                   if (isMaterial2)
@@ -28,6 +28,7 @@ import 'package:harmonoid/features/now_playing/now_playing_colors.dart';
 import 'package:harmonoid/features/now_playing/now_playing_audio_control_panel.dart';
 import 'package:harmonoid/features/now_playing/now_playing_lyrics_control_panel.dart';
 import 'package:harmonoid/features/now_playing/now_playing_lyrics.dart';
+import 'package:harmonoid/features/now_playing/state/now_playing_waveform_notifier.dart';
 import 'package:harmonoid/utils/constants.dart';
 import 'package:harmonoid/third_party/material_wave_slider.dart';
 import 'package:harmonoid/utils/rendering.dart';
@@ -337,6 +338,7 @@ class _ControlsState extends State<Controls> {
                                 value: sliderValue,
                                 onChanged: (value) => mediaPlayer.seek(Duration(milliseconds: value.round())),
                                 paused: !mediaPlayer.state.playing,
+                                peaks: context.watch<NowPlayingWaveformNotifier>().peaks,
                               )
                             : ScrollableSlider(
                                 min: sliderMin,
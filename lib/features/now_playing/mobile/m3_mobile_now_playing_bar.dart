@@ -24,6 +24,7 @@ import 'package:harmonoid/features/now_playing/now_playing_colors.dart';
 import 'package:harmonoid/features/now_playing/now_playing_playlist_item.dart';
 import 'package:harmonoid/features/now_playing/state/now_playing_color_palette_notifier.dart';
 import 'package:harmonoid/features/now_playing/state/now_playing_mobile_notifier.dart';
+import 'package:harmonoid/features/now_playing/state/now_playing_waveform_notifier.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/mappers/build_context.dart';
 import 'package:harmonoid/routing/router.dart';
@@ -649,6 +650,7 @@ class Controls extends StatelessWidget {
                     value: sliderValue,
                     onChanged: (value) => mediaPlayer.seek(Duration(milliseconds: value.round())),
                     paused: !mediaPlayer.state.playing,
+                    peaks: context.watch<NowPlayingWaveformNotifier>().peaks,
                   ),
                 ),
               ),
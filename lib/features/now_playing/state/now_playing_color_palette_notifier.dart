@@ -1,12 +1,16 @@
 import 'dart:async';
+import 'dart:io';
 import 'package:flutter/widgets.dart';
+import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
 import 'package:synchronized/synchronized.dart';
 
+import 'package:harmonoid/core/configuration/configuration.dart';
+import 'package:harmonoid/core/cover_store.dart';
+import 'package:harmonoid/core/filesystem_media_library.dart';
 import 'package:harmonoid/core/media_player/media_player.dart';
 import 'package:harmonoid/extensions/media_player_state.dart';
 import 'package:harmonoid/core/media_player/models/playable.dart';
-import 'package:harmonoid/third_party/palette_generator.dart';
-import 'package:harmonoid/utils/rendering.dart';
+import 'package:harmonoid/utils/palette_cache.dart';
 
 /// {@template now_playing_color_palette_notifier}
 ///
@@ -51,11 +55,12 @@ class NowPlayingColorPaletteNotifier extends ChangeNotifier {
     return _updateLock.synchronized(() async {
       _updateInvoked = false;
       try {
-        final image = cover(uri: playable.uri, cacheWidth: 20);
-        final result = await PaletteGenerator.fromImageProvider(image);
+        final uri = await FileSystemMediaLibrary.instance.coverForUri(playable.uri);
+        final file = uri == null ? await FileSystemMediaLibrary.instance.getDefaultCoverFile() : File(uri.toFilePath());
+        final result = await PaletteCache.instance.obtain(file, identity: await CoverStore.instance.identify(file));
         // Return prematurely if the method has been invoked again.
         if (_updateInvoked) return;
-        palette = result.colors?.toList();
+        palette = result;
         notifyListeners();
       } catch (exception, stacktrace) {
         debugPrint(exception.toString());
@@ -66,6 +71,37 @@ class NowPlayingColorPaletteNotifier extends ChangeNotifier {
     });
   }
 
+  /// Extracts & persists the color palettes of all the album covers in the media library.
+  ///
+  /// Palettes are keyed by [CoverStore] identity, so the per-track cover files looked up by [update] share the palette of their album
+  /// cover. This allows [update] to only perform a lookup when tracks are being skipped.
+  Future<void> precompute() async {
+    if (_precomputeInvoked) return;
+    _precomputeInvoked = true;
+    try {
+      final mediaLibrary = FileSystemMediaLibrary.instance;
+      final sources = <(File, String?)>[];
+      for (final album in mediaLibrary.albums.toList()) {
+        if (mediaLibrary.refreshing) return;
+        try {
+          final uri = await mediaLibrary.cover(album, fallback: Configuration.instance.mediaLibraryCoverFallback);
+          if (uri == null) continue;
+          final file = File(uri.toFilePath());
+          sources.add((file, await CoverStore.instance.identify(file)));
+        } catch (exception, stacktrace) {
+          debugPrint(exception.toString());
+          debugPrint(stacktrace.toString());
+        }
+      }
+      await PaletteCache.instance.precompute(sources, cancel: () => mediaLibrary.refreshing);
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+    } finally {
+      _precomputeInvoked = false;
+    }
+  }
+
   /// Clears the currently extracted [palette] & notifies the listeners.
   void clear() {
     palette = null;
@@ -92,6 +128,9 @@ class NowPlayingColorPaletteNotifier extends ChangeNotifier {
   /// Whether [update] has been invoked.
   bool _updateInvoked = false;
 
+  /// Whether [precompute] has been invoked.
+  bool _precomputeInvoked = false;
+
   /// Mutual exclusion in [update] invocations.
   final Lock _updateLock = Lock();
 }
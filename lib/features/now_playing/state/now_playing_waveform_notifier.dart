@@ -0,0 +1,82 @@
+import 'dart:async';
+import 'package:flutter/widgets.dart';
+
+import 'package:harmonoid/core/audio_analyzer.dart';
+import 'package:harmonoid/core/media_player/media_player.dart';
+import 'package:harmonoid/extensions/media_player_state.dart';
+
+/// {@template now_playing_waveform_notifier}
+///
+/// NowPlayingWaveformNotifier
+/// --------------------------
+/// Implementation to notify widget tree about the waveform of the currently playing track.
+///
+/// {@endtemplate}
+class NowPlayingWaveformNotifier extends ChangeNotifier {
+  /// Number of upcoming tracks analyzed ahead, so that their waveforms are available straight away upon track change.
+  static const int kLookahead = 2;
+
+  /// Singleton instance.
+  static final NowPlayingWaveformNotifier instance = NowPlayingWaveformNotifier._();
+
+  /// Whether the [instance] is initialized.
+  static bool initialized = false;
+
+  /// {@macro now_playing_waveform_notifier}
+  NowPlayingWaveformNotifier._();
+
+  /// Initializes the [instance].
+  static Future<void> ensureInitialized() async {
+    if (initialized) return;
+    initialized = true;
+    WidgetsBinding.instance.addPostFrameCallback((_) => instance.listener());
+    MediaPlayer.instance.addListener(instance.listener);
+    instance._subscription = AudioAnalyzer.instance.analyzed.listen(instance._load);
+  }
+
+  /// Normalized (0.0 to 1.0) peaks of the currently playing track.
+  List<double>? peaks;
+
+  /// Listener to load the waveform of current [Playable] in [MediaPlayer].
+  void listener() {
+    if (MediaPlayer.instance.state.isNotEmpty) {
+      update(MediaPlayer.instance.current.uri);
+    }
+  }
+
+  /// Updates the [peaks] based on the specified [uri].
+  Future<void> update(String uri) async {
+    if (_current == uri) return;
+    _current = uri;
+    final state = MediaPlayer.instance.state;
+    AudioAnalyzer.instance.enqueue(state.playables.skip(state.index + 1).take(kLookahead).map((e) => e.uri));
+    if (!await _load(uri)) {
+      // Analyze the track ahead of the others, [peaks] are updated once it completes.
+      AudioAnalyzer.instance.prioritize(uri);
+    }
+  }
+
+  /// Loads the [peaks] of [uri] if it is the current one. Returns whether the waveform is available.
+  Future<bool> _load(String uri) async {
+    if (_current != uri) return false;
+    final waveform = await AudioAnalyzer.instance.waveform(uri);
+    // Return prematurely if [update] has been invoked again.
+    if (_current != uri) return true;
+    peaks = waveform?.peaks;
+    notifyListeners();
+    return waveform != null;
+  }
+
+  /// Disposes the [instance]. Releases allocated resources back to the system.
+  @override
+  void dispose() {
+    super.dispose();
+    MediaPlayer.instance.removeListener(listener);
+    _subscription?.cancel();
+  }
+
+  /// Current URI.
+  String? _current;
+
+  StreamSubscription<String>? _subscription;
+}
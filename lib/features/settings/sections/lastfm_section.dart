@@ -64,6 +64,8 @@ class _LastfmSectionState extends State<LastfmSection> {
 
     await _instance?.authenticate(launchUrl);
     await Configuration.instance.set(lastfmSession: _instance?.session);
+    // Resume the scrobbles held back by a previously invalid session.
+    MediaPlayer.instance.mixinRegistry.get<LastFmMixin>()?.scrobbleQueue.notify();
 
     setState(() {});
     pop();
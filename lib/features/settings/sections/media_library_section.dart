@@ -9,6 +9,7 @@ import 'package:provider/provider.dart';
 
 import 'package:harmonoid/core/configuration/configuration.dart';
 import 'package:harmonoid/core/filesystem_media_library.dart';
+import 'package:harmonoid/core/media_library_watcher.dart';
 import 'package:harmonoid/extensions/configuration.dart';
 import 'package:harmonoid/extensions/set.dart';
 import 'package:harmonoid/localization/localization.dart';
@@ -104,6 +105,8 @@ class MediaLibrarySection extends StatelessWidget {
       // }
       await Configuration.instance.removeMediaLibraryDirectory(directory);
       await mediaLibrary.removeDirectories({directory});
+      // An empty set of dirty directories only brings the journaled & watched directories up-to-date.
+      MediaLibraryWatcher.instance.reconcile(dirty: {});
       if (Platform.isMacOS || Platform.isIOS) {
         await DarwinStorageController.instance.invalidateAccess(directory);
       }
@@ -116,6 +119,8 @@ class MediaLibrarySection extends StatelessWidget {
       if (directory == null) return;
       await Configuration.instance.addMediaLibraryDirectory(directory);
       await mediaLibrary.addDirectories({directory});
+      // An empty set of dirty directories only brings the journaled & watched directories up-to-date.
+      MediaLibraryWatcher.instance.reconcile(dirty: {});
     });
   }
 
@@ -123,7 +128,11 @@ class MediaLibrarySection extends StatelessWidget {
     return ensureNotRefreshing(
       context,
       mediaLibrary,
-      mediaLibrary.refresh,
+      () async {
+        await mediaLibrary.refresh();
+        // Re-write the journal from the refreshed state, so that the next reconcile only applies later changes.
+        MediaLibraryWatcher.instance.seed();
+      },
     );
   }
 
@@ -5,18 +5,26 @@ import 'package:flutter/material.dart' hide Intent;
 import 'package:flutter/services.dart';
 import 'package:identity/identity.dart';
 import 'package:media_kit/media_kit.dart';
+import 'package:path/path.dart';
 import 'package:permission_handler/permission_handler.dart';
 
+import 'package:harmonoid/core/audio_analyzer.dart';
 import 'package:harmonoid/core/configuration/configuration.dart';
 import 'package:harmonoid/core/configuration/database/constants.dart';
+import 'package:harmonoid/core/cover_store.dart';
 import 'package:harmonoid/core/filesystem_media_library.dart';
 import 'package:harmonoid/core/intent.dart';
+import 'package:harmonoid/core/media_library_search_index.dart';
+import 'package:harmonoid/core/media_library_watcher.dart';
 import 'package:harmonoid/core/media_player/media_player.dart';
+import 'package:harmonoid/core/media_player/playback_queue_journal.dart';
+import 'package:harmonoid/core/track_sort_index.dart';
 import 'package:harmonoid/extensions/string.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/state/in_app_review_notifier.dart';
 import 'package:harmonoid/state/lyrics/lyrics_notifier.dart';
 import 'package:harmonoid/features/now_playing/state/now_playing_color_palette_notifier.dart';
+import 'package:harmonoid/features/now_playing/state/now_playing_waveform_notifier.dart';
 import 'package:harmonoid/features/now_playing/state/now_playing_visuals_notifier.dart';
 import 'package:harmonoid/state/theme_notifier.dart';
 import 'package:harmonoid/features/app/exception.dart';
@@ -25,11 +33,14 @@ import 'package:harmonoid/features/app/splash.dart';
 import 'package:harmonoid/utils/android_storage_controller.dart';
 import 'package:harmonoid/utils/constants.dart';
 import 'package:harmonoid/utils/darwin_storage_controller.dart';
+import 'package:harmonoid/utils/palette_cache.dart';
 import 'package:harmonoid/utils/platform_utils.dart';
+import 'package:harmonoid/utils/startup_trace.dart';
+import 'package:harmonoid/utils/thumbnail_cache.dart';
 import 'package:harmonoid/utils/window_lifecycle.dart';
 
 Future<void> main(List<String> args) async {
-  WidgetsFlutterBinding.ensureInitialized();
+  await StartupTrace.instance.span('WidgetsFlutterBinding', WidgetsFlutterBinding.ensureInitialized);
   PaintingBinding.instance.imageCache.maximumSize = 1000;
   PaintingBinding.instance.imageCache.maximumSizeBytes = 200 * 1024 * 1024;
   try {
@@ -79,58 +90,79 @@ Future<void> main(List<String> args) async {
       ]);
     }
     if (Platform.isLinux || Platform.isMacOS || Platform.isWindows) {
-      await WindowPlus.ensureInitialized(
-        application: kApplication,
-        enableEventStreams: false,
-      );
-      await WindowPlus.instance.setMinimumSize(const Size(1024.0, 600.0));
+      await StartupTrace.instance.span('WindowPlus', () async {
+        await WindowPlus.ensureInitialized(
+          application: kApplication,
+          enableEventStreams: false,
+        );
+        await WindowPlus.instance.setMinimumSize(const Size(1024.0, 600.0));
+      });
       WindowLifecycle.ensureInitialized();
       runApp(const SplashApp());
     }
-    PlatformUtils.ensureInitialized();
-    await Configuration.ensureInitialized();
-    await IdentityNotifier.ensureInitialized(
-      getItem: (key) => Configuration.instance.db.getString(key),
-      setItem: (key, value) => Configuration.instance.db.setValue(key, kTypeString, stringValue: value),
-      removeItem: (key) => Configuration.instance.db.remove(key),
-      deviceId: Configuration.instance.identifier,
+    await StartupTrace.instance.span('PlatformUtils', () => PlatformUtils.ensureInitialized());
+    await StartupTrace.instance.span('Configuration', () => Configuration.ensureInitialized());
+    await StartupTrace.instance.span(
+      'IdentityNotifier',
+      () => IdentityNotifier.ensureInitialized(
+        getItem: (key) => Configuration.instance.db.getString(key),
+        setItem: (key, value) => Configuration.instance.db.setValue(key, kTypeString, stringValue: value),
+        removeItem: (key) => Configuration.instance.db.remove(key),
+        deviceId: Configuration.instance.identifier,
+      ),
     );
-    await SubscriptionNotifier.ensureInitialized();
+    await StartupTrace.instance.span('SubscriptionNotifier', () => SubscriptionNotifier.ensureInitialized());
 
     if (Platform.isMacOS || Platform.isIOS) {
-      await DarwinStorageController.ensureInitialized(directories: Configuration.instance.mediaLibraryDirectories);
+      await StartupTrace.instance.span('DarwinStorageController', () => DarwinStorageController.ensureInitialized(directories: Configuration.instance.mediaLibraryDirectories));
     }
 
-    MediaKit.ensureInitialized(libmpv: Configuration.instance.mpvPath.nullIfBlank());
-    await Localization.ensureInitialized(localization: Configuration.instance.localization);
-    await FileSystemMediaLibrary.ensureInitialized(
-      cache: Configuration.instance.directory,
-      directories: Configuration.instance.mediaLibraryDirectories,
-      albumSortType: Configuration.instance.mediaLibraryAlbumSortType,
-      artistSortType: Configuration.instance.mediaLibraryArtistSortType,
-      genreSortType: Configuration.instance.mediaLibraryGenreSortType,
-      trackSortType: Configuration.instance.mediaLibraryTrackSortType,
-      albumSortAscending: Configuration.instance.mediaLibraryAlbumSortAscending,
-      artistSortAscending: Configuration.instance.mediaLibraryArtistSortAscending,
-      genreSortAscending: Configuration.instance.mediaLibraryGenreSortAscending,
-      trackSortAscending: Configuration.instance.mediaLibraryTrackSortAscending,
-      minimumFileSize: Configuration.instance.mediaLibraryMinimumFileSize,
-      albumGroupingParameters: Configuration.instance.mediaLibraryAlbumGroupingParameters,
-      hideSecondaryArtists: Configuration.instance.mediaLibraryHideSecondaryArtists,
+    await StartupTrace.instance.span('MediaKit', () => MediaKit.ensureInitialized(libmpv: Configuration.instance.mpvPath.nullIfBlank()));
+    await StartupTrace.instance.span('Localization', () => Localization.ensureInitialized(localization: Configuration.instance.localization));
+    await StartupTrace.instance.span(
+      'FileSystemMediaLibrary',
+      () => FileSystemMediaLibrary.ensureInitialized(
+        cache: Configuration.instance.directory,
+        directories: Configuration.instance.mediaLibraryDirectories,
+        albumSortType: Configuration.instance.mediaLibraryAlbumSortType,
+        artistSortType: Configuration.instance.mediaLibraryArtistSortType,
+        genreSortType: Configuration.instance.mediaLibraryGenreSortType,
+        trackSortType: Configuration.instance.mediaLibraryTrackSortType,
+        albumSortAscending: Configuration.instance.mediaLibraryAlbumSortAscending,
+        artistSortAscending: Configuration.instance.mediaLibraryArtistSortAscending,
+        genreSortAscending: Configuration.instance.mediaLibraryGenreSortAscending,
+        trackSortAscending: Configuration.instance.mediaLibraryTrackSortAscending,
+        minimumFileSize: Configuration.instance.mediaLibraryMinimumFileSize,
+        albumGroupingParameters: Configuration.instance.mediaLibraryAlbumGroupingParameters,
+        hideSecondaryArtists: Configuration.instance.mediaLibraryHideSecondaryArtists,
+      ),
     );
-    await MediaPlayer.ensureInitialized();
-    await Intent.ensureInitialized(args: args);
-    await ThemeNotifier.ensureInitialized(
-      themeMode: Configuration.instance.themeMode,
-      materialStandard: Configuration.instance.themeMaterialStandard,
-      systemColorScheme: Configuration.instance.themeSystemColorScheme,
-      animationDuration: Configuration.instance.themeAnimationDuration,
+    await StartupTrace.instance.span('MediaLibrarySearchIndex', () => MediaLibrarySearchIndex.ensureInitialized());
+    await StartupTrace.instance.span('TrackSortIndex', () => TrackSortIndex.ensureInitialized());
+    await StartupTrace.instance.span('MediaLibraryWatcher', () => MediaLibraryWatcher.ensureInitialized(cache: Configuration.instance.directory));
+    await StartupTrace.instance.span('ThumbnailCache', () => ThumbnailCache.ensureInitialized(directory: Directory(join(FileSystemMediaLibrary.instance.covers.path, 'Thumbnails'))));
+    await StartupTrace.instance.span('PaletteCache', () => PaletteCache.ensureInitialized(directory: Directory(join(FileSystemMediaLibrary.instance.covers.path, 'Palettes'))));
+    await StartupTrace.instance.span('CoverStore', () => CoverStore.ensureInitialized());
+    await StartupTrace.instance.span('AudioAnalyzer', () => AudioAnalyzer.ensureInitialized(directory: Configuration.instance.directory));
+    await StartupTrace.instance.span('PlaybackQueueJournal', () => PlaybackQueueJournal.ensureInitialized(directory: Configuration.instance.directory));
+    await StartupTrace.instance.span('MediaPlayer', () => MediaPlayer.ensureInitialized());
+    await StartupTrace.instance.span('Intent', () => Intent.ensureInitialized(args: args));
+    await StartupTrace.instance.span(
+      'ThemeNotifier',
+      () => ThemeNotifier.ensureInitialized(
+        themeMode: Configuration.instance.themeMode,
+        materialStandard: Configuration.instance.themeMaterialStandard,
+        systemColorScheme: Configuration.instance.themeSystemColorScheme,
+        animationDuration: Configuration.instance.themeAnimationDuration,
+      ),
     );
-    await LyricsNotifier.ensureInitialized();
-    await InAppReviewNotifier.ensureInitialized();
-    await NowPlayingVisualsNotifier.ensureInitialized();
-    await NowPlayingColorPaletteNotifier.ensureInitialized();
+    await StartupTrace.instance.span('LyricsNotifier', () => LyricsNotifier.ensureInitialized());
+    await StartupTrace.instance.span('InAppReviewNotifier', () => InAppReviewNotifier.ensureInitialized());
+    await StartupTrace.instance.span('NowPlayingVisualsNotifier', () => NowPlayingVisualsNotifier.ensureInitialized());
+    await StartupTrace.instance.span('NowPlayingColorPaletteNotifier', () => NowPlayingColorPaletteNotifier.ensureInitialized());
+    await StartupTrace.instance.span('NowPlayingWaveformNotifier', () => NowPlayingWaveformNotifier.ensureInitialized());
     runApp(const HarmonoidApp());
+    StartupTrace.instance.finish();
   } catch (exception, stacktrace) {
     debugPrint(exception.toString());
     debugPrint(stacktrace.toString());
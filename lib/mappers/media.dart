@@ -6,4 +6,7 @@ import 'package:harmonoid/core/media_player/models/playable.dart';
 extension MediaMappers on Media {
   /// Converts to [Playable].
   Playable toPlayable() => Playable.fromJson(extras ?? {});
+
+  /// URI of the corresponding [Playable]; differs from [uri] if playback is redirected (e.g. to a local copy).
+  String get playableUri => extras?['uri'] ?? uri;
 }
@@ -1,12 +1,15 @@
 import 'package:harmonoid/core/media_player/models/media_player_state.dart';
 import 'package:harmonoid/core/media_player/models/playback_state.dart';
+import 'package:harmonoid/core/media_player/playback_queue_journal.dart';
 
 /// Mappers for [MediaPlayerState].
 extension MediaPlayerStateMappers on MediaPlayerState {
   /// Converts to [PlaybackState].
+  ///
+  /// [playables] are not included, these are persisted by [PlaybackQueueJournal] as they change.
   PlaybackState toPlaybackState() => PlaybackState(
     index: index,
-    playables: playables,
+    playables: const [],
     rate: rate,
     pitch: pitch,
     volume: volume,
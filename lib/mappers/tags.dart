@@ -1,14 +1,16 @@
 import 'package:media_library/media_library.dart';
 import 'package:tag_reader/tag_reader.dart';
 
+import 'package:harmonoid/utils/string_interner.dart';
+
 /// Mappers for [Tags].
 extension TagsMappers on Tags {
-  /// Converts to [Track].
-  Track toTrack() => Track(
+  /// Converts to [Track]. Repeated values i.e. album, album artist, artists & genres are de-duplicated with [interner], if specified.
+  Track toTrack({StringInterner? interner}) => Track(
         uri: uri,
         title: title,
-        album: album,
-        albumArtist: albumArtist,
+        album: interner?.call(album) ?? album,
+        albumArtist: interner?.call(albumArtist) ?? albumArtist,
         discNumber: discNumber,
         trackNumber: trackNumber,
         albumLength: albumLength,
@@ -17,7 +19,7 @@ extension TagsMappers on Tags {
         duration: duration,
         bitrate: bitrate,
         timestamp: timestamp,
-        artists: artists,
-        genres: genres,
+        artists: interner?.all(artists) ?? artists,
+        genres: interner?.all(genres) ?? genres,
       );
 }
@@ -15,16 +15,15 @@ import 'package:harmonoid/state/lyrics/models/lyrics.dart';
 class LyricsGet {
   Future<Lyrics?> call(String track, String artist, int duration) async {
     try {
+      const path = '/functions/v1/lyrics-get';
+      final parameters = {
+        'track': track,
+        'artist': artist,
+        'duration': duration.toString(),
+      };
       final response = await http.get(
-        Uri.https(
-          apiBaseUrl,
-          '/functions/v1/lyrics-get',
-          {
-            'track': track,
-            'artist': artist,
-            'duration': duration.toString(),
-          },
-        ),
+        // NOTE: A base URL with a scheme (e.g. http://127.0.0.1:8082 for a local stand-in) is used as-is.
+        apiBaseUrl.contains('://') ? Uri.parse(apiBaseUrl).replace(path: path, queryParameters: parameters) : Uri.https(apiBaseUrl, path, parameters),
         headers: {
           'Content-Type': 'application/json',
           'X-API-Key': apiKey,
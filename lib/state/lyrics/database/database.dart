@@ -61,6 +61,25 @@ class LyricsDatabase extends _$LyricsDatabase {
     );
   }
 
+  /// Sets the cached lyrics of each entry in [entries] in a single transaction.
+  Future<void> setLyricsAll(Map<LyricsKey, Lyrics> entries) async {
+    await batch((batch) {
+      batch.insertAll(
+        lyricss,
+        [
+          for (final MapEntry(key: key, value: lyrics) in entries.entries)
+            LyricsEntity(
+              track: key.track,
+              artist: key.artist,
+              duration: key.duration,
+              lyrics: lyrics,
+            ),
+        ],
+        mode: InsertMode.insertOrReplace,
+      );
+    });
+  }
+
   /// Removes the cached lyrics with the given [key].
   Future<void> removeLyrics(LyricsKey key) async {
     final query = delete(lyricss)..where((e) => e.track.equals(key.track) & e.artist.equals(key.artist));
@@ -93,6 +112,27 @@ class LyricsDatabase extends _$LyricsDatabase {
     );
   }
 
+  /// Sets the cached lyrics translation of each entry in [entries] in a single transaction.
+  Future<void> setLyricsTranslationAll(Map<LyricsTranslationKey, LyricsTranslation> entries) async {
+    await batch((batch) {
+      batch.insertAll(
+        lyricsTranslations,
+        [
+          for (final MapEntry(key: key, value: lyricsTranslation) in entries.entries)
+            LyricsTranslationEntity(
+              track: key.track,
+              artist: key.artist,
+              duration: key.duration,
+              language: key.language,
+              lyrics: lyricsTranslation.lyrics,
+              same: lyricsTranslation.same,
+            ),
+        ],
+        mode: InsertMode.insertOrReplace,
+      );
+    });
+  }
+
   static LazyDatabase _openConnection(Directory directory) {
     return LazyDatabase(() async {
       final file = File(path.join(directory.path, 'Lyrics.DB'));
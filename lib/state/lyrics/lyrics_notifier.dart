@@ -2,16 +2,12 @@
 
 import 'dart:async';
 import 'dart:collection';
-import 'dart:convert';
 import 'dart:io';
 import 'dart:math';
-import 'package:crypto/crypto.dart';
 import 'package:flutter/foundation.dart';
 import 'package:flutter_local_notifications/flutter_local_notifications.dart';
 import 'package:identity/identity.dart';
-import 'package:lrc/lrc.dart';
 import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
-import 'package:path/path.dart';
 import 'package:permission_handler/permission_handler.dart';
 import 'package:provider/provider.dart';
 import 'package:safe_local_storage/safe_local_storage.dart';
@@ -23,13 +19,10 @@ import 'package:harmonoid/core/media_player/media_player.dart';
 import 'package:harmonoid/core/media_player/models/playable.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/localization/models/language.dart';
-import 'package:harmonoid/mappers/lyrics_key.dart';
-import 'package:harmonoid/mappers/playable.dart';
 import 'package:harmonoid/mappers/track.dart';
 import 'package:harmonoid/routing/router.dart';
-import 'package:harmonoid/state/lyrics/api/lyrics_get.dart';
-import 'package:harmonoid/state/lyrics/api/lyrics_translation_get.dart';
 import 'package:harmonoid/state/lyrics/database/database.dart';
+import 'package:harmonoid/state/lyrics/lyrics_resolver.dart';
 import 'package:harmonoid/state/lyrics/models/lyric.dart';
 import 'package:harmonoid/state/lyrics/models/lyrics.dart';
 import 'package:harmonoid/state/remote_config/models/remote_config_key.dart';
@@ -82,6 +75,7 @@ class LyricsNotifier extends ChangeNotifier {
           _currentDuration = currentDuration;
           await _fetchLyrics();
           await _fetchLyricsTranslation();
+          _prefetch();
 
           for (int i = 0; i < lyrics.length; i++) {
             _timestampsAndIndexes[lyrics[i].timestamp] = i;
@@ -170,7 +164,7 @@ class LyricsNotifier extends ChangeNotifier {
 
   /// Whether cached lyrics are present for the specified [track].
   Future<bool> contains(Track track) async {
-    return await db.containsLyrics(track.toLyricsKey()) || await _legacyLrcCacheFileForUri(track.uri).exists_();
+    return await db.containsLyrics(track.toLyricsKey()) || await LyricsResolver.legacyLrcCacheFileForUri(track.uri).exists_();
   }
 
   /// Adds .LRC contents to the SQLite lyrics cache for the specified [track].
@@ -179,7 +173,7 @@ class LyricsNotifier extends ChangeNotifier {
       final contents = await file.readAsString_();
       if (contents == null) return false;
 
-      final lyrics = _parseLrc(contents);
+      final lyrics = LyricsResolver.parseLrc(contents);
       if (lyrics == null) return false;
 
       await db.setLyrics(track.toLyricsKey(), lyrics);
@@ -194,13 +188,14 @@ class LyricsNotifier extends ChangeNotifier {
   /// Removes cached lyrics for the specified [track].
   Future<void> remove(Track track) async {
     try {
+      _resolver.evict(track.toLyricsKey());
       await db.removeLyrics(track.toLyricsKey());
     } catch (exception, stacktrace) {
       debugPrint(exception.toString());
       debugPrint(stacktrace.toString());
     }
     try {
-      await _legacyLrcCacheFileForUri(track.uri).delete();
+      await LyricsResolver.legacyLrcCacheFileForUri(track.uri).delete();
     } catch (exception, stacktrace) {
       debugPrint(exception.toString());
       debugPrint(stacktrace.toString());
@@ -213,6 +208,15 @@ class LyricsNotifier extends ChangeNotifier {
     notifyListeners();
   }
 
+  /// Writes the pending lyrics & translations (e.g. fetched from the API) to the database.
+  Future<void> flush() => _resolver.flush();
+
+  @override
+  void dispose() {
+    unawaited(flush());
+    super.dispose();
+  }
+
   /// Fetches lyrics for currently playing [Playable].
   Future<void> _fetchLyrics() async {
     final localCurrent = _current;
@@ -225,88 +229,7 @@ class LyricsNotifier extends ChangeNotifier {
       notifyListeners();
     }
 
-    Lyrics? result;
-
-    final key = localCurrent.toLyricsKey(localCurrentDuration);
-
-    // 1. Drift cache.
-
-    if (result == null) {
-      debugPrint('LyricsNotifier: _fetchLyrics: Drift: ${localCurrent.uri}');
-      try {
-        result = await db.getLyrics(key);
-      } catch (exception, stacktrace) {
-        debugPrint(exception.toString());
-        debugPrint(stacktrace.toString());
-      }
-    }
-
-    // 2. Legacy LRC cache.
-
-    if (result == null) {
-      debugPrint('LyricsNotifier: _fetchLyrics: Legacy LRC: ${localCurrent.uri}');
-      result = await _legacyReadLrcCache(localCurrent);
-    }
-
-    // 3. Tags.
-
-    if (result == null) {
-      debugPrint('LyricsNotifier: _fetchLyrics: Tags: ${localCurrent.uri}');
-      try {
-        final track = FileSystemMediaLibrary.instance.lookupTrack(TrackLookupKey(uri: localCurrent.uri));
-        if (track != null && LrcParser.isValid(track.lyrics)) {
-          result = _parseLrc(track.lyrics);
-        }
-      } catch (exception, stacktrace) {
-        debugPrint(exception.toString());
-        debugPrint(stacktrace.toString());
-      }
-    }
-
-    // 4. Directory.
-
-    if (result == null) {
-      debugPrint('LyricsNotifier: _fetchLyrics: Directory: ${localCurrent.uri}');
-      try {
-        if (Configuration.instance.lrcFromDirectory) {
-          final dir = dirname(localCurrent.uri);
-          final name = basenameWithoutExtension(localCurrent.uri);
-          final files = [
-            File(join(dir, '$name.lrc')),
-            File(join(dir, '$name.LRC')),
-          ];
-          for (final file in files) {
-            final contents = await file.readAsString_();
-            if (contents != null) result = _parseLrc(contents);
-            if (result != null) break;
-          }
-        }
-      } catch (exception, stacktrace) {
-        debugPrint(exception.toString());
-        debugPrint(stacktrace.toString());
-      }
-    }
-
-    // 5. API.
-
-    if (result == null) {
-      debugPrint('LyricsNotifier: _fetchLyrics: API: ${localCurrent.uri}');
-      try {
-        final lyricsGet = LyricsGet();
-        final response = await lyricsGet.call(
-          localCurrent.title,
-          localCurrent.subtitle.firstOrNull ?? '',
-          localCurrentDuration.inMilliseconds,
-        );
-        if (response != null) {
-          result = response;
-          await db.setLyrics(key, response);
-        }
-      } catch (exception, stacktrace) {
-        debugPrint(exception.toString());
-        debugPrint(stacktrace.toString());
-      }
-    }
+    final result = await _resolver.resolve(localCurrent, localCurrentDuration);
 
     if (_isCurrentGuard(localCurrent, localCurrentDuration)) {
       lyricsLoading = false;
@@ -336,48 +259,7 @@ class LyricsNotifier extends ChangeNotifier {
       notifyListeners();
     }
 
-    Lyrics? result;
-
-    final key = localCurrent.toLyricsKey(localCurrentDuration).toLyricsTranslationKey(localTranslationLanguage.code);
-
-    // 1. Drift cache.
-
-    debugPrint('LyricsNotifier: _fetchLyricsTranslation: Drift: ${localCurrent.uri}');
-    try {
-      final response = await db.getLyricsTranslation(key);
-      result = response?.lyrics;
-    } catch (exception, stacktrace) {
-      debugPrint(exception.toString());
-      debugPrint(stacktrace.toString());
-    }
-
-    // 2. API.
-
-    // NOTE: We want to hit the API even if cache already had it (to refresh).
-
-    debugPrint('LyricsNotifier: _fetchLyricsTranslation: API: ${localCurrent.uri}');
-    try {
-      final lyricsTranslationGet = LyricsTranslationGet();
-      final response = await lyricsTranslationGet.call(
-        lyrics,
-        '${localTranslationLanguage.name} (${localTranslationLanguage.code})',
-        localCurrent.title,
-        localCurrent.subtitle.firstOrNull ?? '',
-        localCurrentDuration.inMilliseconds,
-      );
-      if (response != null) {
-        if (response.same) {
-          result = [];
-          await db.setLyricsTranslation(key, response);
-        } else if (response.lyrics != null && response.lyrics?.length == lyrics.length) {
-          result = response.lyrics;
-          await db.setLyricsTranslation(key, response);
-        }
-      }
-    } catch (exception, stacktrace) {
-      debugPrint(exception.toString());
-      debugPrint(stacktrace.toString());
-    }
+    final result = await _resolver.resolveTranslation(localCurrent, localCurrentDuration, lyrics, localTranslationLanguage);
 
     if (_isCurrentGuard(localCurrent, localCurrentDuration)) {
       translationLoading = false;
@@ -386,6 +268,20 @@ class LyricsNotifier extends ChangeNotifier {
     }
   }
 
+  /// Resolves the lyrics & translations of the upcoming entries of the queue in the background.
+  void _prefetch() {
+    final state = MediaPlayer.instance.state;
+    final language = translationLanguage.code.isNotEmpty && subscriptionNotifier?.state is SubscriptionValid ? translationLanguage : null;
+    _resolver.prefetch(
+      [
+        for (final playable in state.playables.skip(state.index + 1).take(LyricsResolver.kPrefetchCount))
+          // NOTE: Duration is only known for the entries present in the media library.
+          (playable, Duration(milliseconds: FileSystemMediaLibrary.instance.lookupTrack(TrackLookupKey(uri: playable.uri))?.duration ?? 0)),
+      ],
+      language: language,
+    );
+  }
+
   /// Fetches the translation languages.
   Future<void> _fetchTranslationLanguages() async {
     final remoteConfigProvider = RemoteConfigProvider();
@@ -396,12 +292,6 @@ class LyricsNotifier extends ChangeNotifier {
     }
   }
 
-  Lyrics? _parseLrc(String contents) {
-    if (!LrcParser.isValid(contents)) return null;
-    final lrc = LrcParser.parse(contents);
-    return lrc.lyrics.map((e) => Lyric(timestamp: (lrc.offset ?? 0) + e.timestamp.inMilliseconds, text: e.lyrics.trim())).toList();
-  }
-
   bool _isCurrentGuard(Playable? playable, Duration? duration, [Language? language]) {
     try {
       return playable == MediaPlayer.instance.current && duration == MediaPlayer.instance.state.duration && (language == null ? true : language == translationLanguage);
@@ -410,22 +300,6 @@ class LyricsNotifier extends ChangeNotifier {
     }
   }
 
-  Future<Lyrics?> _legacyReadLrcCache(Playable playable) async {
-    try {
-      final file = _legacyLrcCacheFileForUri(playable.uri);
-      final contents = await file.readAsString_();
-      if (contents == null) return null;
-
-      return _parseLrc(contents);
-    } catch (exception, stacktrace) {
-      debugPrint(exception.toString());
-      debugPrint(stacktrace.toString());
-    }
-    return null;
-  }
-
-  File _legacyLrcCacheFileForUri(String uri) => File(join(Configuration.instance.directory.path, 'Lyrics', '${sha256.convert(utf8.encode(uri)).toString()}.LRC'));
-
   // --------------------------------------------------
 
   /// Initializes the notification.
@@ -546,6 +420,7 @@ class LyricsNotifier extends ChangeNotifier {
 
   Playable? _current;
   Duration? _currentDuration;
+  late final LyricsResolver _resolver = LyricsResolver(db);
   bool _initializeNotificationInvoked = false;
   final SplayTreeMap<int, int> _timestampsAndIndexes = SplayTreeMap<int, int>();
   final Lock _lock = Lock();
@@ -0,0 +1,309 @@
+import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:io';
+import 'package:crypto/crypto.dart';
+import 'package:flutter/foundation.dart';
+import 'package:lrc/lrc.dart';
+import 'package:media_library/media_library.dart' hide FileSystemMediaLibrary;
+import 'package:path/path.dart';
+import 'package:safe_local_storage/safe_local_storage.dart';
+
+import 'package:harmonoid/core/configuration/configuration.dart';
+import 'package:harmonoid/core/filesystem_media_library.dart';
+import 'package:harmonoid/core/media_player/models/playable.dart';
+import 'package:harmonoid/localization/models/language.dart';
+import 'package:harmonoid/mappers/lyrics_key.dart';
+import 'package:harmonoid/mappers/playable.dart';
+import 'package:harmonoid/state/lyrics/api/lyrics_get.dart';
+import 'package:harmonoid/state/lyrics/api/lyrics_translation_get.dart';
+import 'package:harmonoid/state/lyrics/database/database.dart';
+import 'package:harmonoid/state/lyrics/models/lyric.dart';
+import 'package:harmonoid/state/lyrics/models/lyrics.dart';
+import 'package:harmonoid/state/lyrics/models/lyrics_key.dart';
+import 'package:harmonoid/state/lyrics/models/lyrics_translation.dart';
+import 'package:harmonoid/state/lyrics/models/lyrics_translation_key.dart';
+
+/// {@template lyrics_resolver}
+///
+/// LyricsResolver
+/// --------------
+/// Implementation to resolve lyrics & lyrics translations of [Playable]s.
+///
+/// Lyrics are looked up in order: database, legacy LRC cache, tags, .LRC file in the same directory & the API. [prefetch] resolves the
+/// upcoming entries of the queue in the background, [kConcurrency] at a time. Concurrent requests for the same key share a single
+/// resolution. Results of the API are written to the database in batches.
+///
+/// {@endtemplate}
+class LyricsResolver {
+  /// Number of upcoming entries to prefetch.
+  static const int kPrefetchCount = 3;
+
+  /// Maximum number of concurrent prefetches.
+  static const int kConcurrency = 2;
+
+  /// Number of pending writes after which the database is written to immediately.
+  static const int kBatchSize = 32;
+
+  /// Interval after which pending writes are written to the database.
+  static const Duration kFlushInterval = Duration(seconds: 2);
+
+  /// {@macro lyrics_resolver}
+  LyricsResolver(this.db);
+
+  /// Database used to cache lyrics and lyrics translations.
+  final LyricsDatabase db;
+
+  /// Returns the lyrics of [playable].
+  Future<Lyrics?> resolve(Playable playable, Duration duration) {
+    final key = playable.toLyricsKey(duration);
+    return _lyricsRequests[(key.track, key.artist)] ??= _resolve(playable, key).whenComplete(() => _lyricsRequests.remove((key.track, key.artist)));
+  }
+
+  /// Returns the translation of [lyrics] of [playable] in [language].
+  ///
+  /// The API is invoked even if the translation is cached (to refresh), but only once per session for each key.
+  Future<Lyrics?> resolveTranslation(Playable playable, Duration duration, Lyrics lyrics, Language language) {
+    final key = playable.toLyricsKey(duration).toLyricsTranslationKey(language.code);
+    final id = (key.track, key.artist, key.language);
+    return _translationRequests[id] ??= _resolveTranslation(playable, key, lyrics, language).whenComplete(() => _translationRequests.remove(id));
+  }
+
+  /// Resolves the lyrics (& translation in [language], if specified) of [entries] in the background. Only the most recently requested
+  /// entries are considered, so skipping through the queue does not pile up requests.
+  void prefetch(Iterable<(Playable, Duration)> entries, {Language? language}) {
+    _queue
+      ..clear()
+      ..addAll(entries.where((e) => e.$2 > Duration.zero));
+    _language = language;
+    while (_workers < kConcurrency && _queue.isNotEmpty) {
+      _workers++;
+      _work().whenComplete(() => _workers--);
+    }
+  }
+
+  /// Discards the in-memory state of [key]; invoke after removing it from the database.
+  void evict(LyricsKey key) {
+    _lyricsWrites.remove((key.track, key.artist));
+  }
+
+  /// Writes the pending results to the database.
+  Future<void> flush() async {
+    _flushTimer?.cancel();
+    _flushTimer = null;
+    final lyrics = {for (final (key, value) in _lyricsWrites.values) key: value};
+    final translations = {for (final (key, value) in _translationWrites.values) key: value};
+    _lyricsWrites.clear();
+    _translationWrites.clear();
+    try {
+      if (lyrics.isNotEmpty) await db.setLyricsAll(lyrics);
+      if (translations.isNotEmpty) await db.setLyricsTranslationAll(translations);
+      debugPrint('LyricsResolver: flush: Lyrics: ${lyrics.length}, Translations: ${translations.length}');
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+    }
+  }
+
+  /// Parses the .LRC [contents].
+  static Lyrics? parseLrc(String contents) {
+    if (!LrcParser.isValid(contents)) return null;
+    final lrc = LrcParser.parse(contents);
+    return lrc.lyrics.map((e) => Lyric(timestamp: (lrc.offset ?? 0) + e.timestamp.inMilliseconds, text: e.lyrics.trim())).toList();
+  }
+
+  static File legacyLrcCacheFileForUri(String uri) => File(join(Configuration.instance.directory.path, 'Lyrics', '${sha256.convert(utf8.encode(uri)).toString()}.LRC'));
+
+  Future<void> _work() async {
+    while (_queue.isNotEmpty) {
+      final (playable, duration) = _queue.removeFirst();
+      final language = _language;
+      try {
+        final lyrics = await resolve(playable, duration);
+        if (lyrics != null && lyrics.isNotEmpty && language != null) {
+          await resolveTranslation(playable, duration, lyrics, language);
+        }
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    }
+  }
+
+  Future<Lyrics?> _resolve(Playable playable, LyricsKey key) async {
+    Lyrics? result;
+
+    // 1. Drift cache.
+
+    if (result == null) {
+      debugPrint('LyricsResolver: _resolve: Drift: ${playable.uri}');
+      try {
+        result = _lyricsWrites[(key.track, key.artist)]?.$2 ?? await db.getLyrics(key);
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    }
+
+    // 2. Legacy LRC cache.
+
+    if (result == null) {
+      debugPrint('LyricsResolver: _resolve: Legacy LRC: ${playable.uri}');
+      try {
+        final contents = await legacyLrcCacheFileForUri(playable.uri).readAsString_();
+        if (contents != null) result = parseLrc(contents);
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    }
+
+    // 3. Tags.
+
+    if (result == null) {
+      debugPrint('LyricsResolver: _resolve: Tags: ${playable.uri}');
+      try {
+        final track = FileSystemMediaLibrary.instance.lookupTrack(TrackLookupKey(uri: playable.uri));
+        if (track != null && LrcParser.isValid(track.lyrics)) {
+          result = parseLrc(track.lyrics);
+        }
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    }
+
+    // 4. Directory.
+
+    if (result == null) {
+      debugPrint('LyricsResolver: _resolve: Directory: ${playable.uri}');
+      try {
+        if (Configuration.instance.lrcFromDirectory) {
+          final dir = dirname(playable.uri);
+          final name = basenameWithoutExtension(playable.uri);
+          final files = [
+            File(join(dir, '$name.lrc')),
+            File(join(dir, '$name.LRC')),
+          ];
+          for (final file in files) {
+            final contents = await file.readAsString_();
+            if (contents != null) result = parseLrc(contents);
+            if (result != null) break;
+          }
+        }
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    }
+
+    // 5. API.
+
+    if (result == null) {
+      debugPrint('LyricsResolver: _resolve: API: ${playable.uri}');
+      try {
+        final lyricsGet = LyricsGet();
+        final response = await lyricsGet.call(
+          key.track,
+          key.artist,
+          key.duration,
+        );
+        if (response != null) {
+          result = response;
+          _lyricsWrites[(key.track, key.artist)] = (key, response);
+          _scheduleFlush();
+        }
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    }
+
+    return result;
+  }
+
+  Future<Lyrics?> _resolveTranslation(Playable playable, LyricsTranslationKey key, Lyrics lyrics, Language language) async {
+    Lyrics? result;
+    final id = (key.track, key.artist, key.language);
+
+    // 1. Drift cache.
+
+    debugPrint('LyricsResolver: _resolveTranslation: Drift: ${playable.uri}');
+    try {
+      final response = _translationWrites[id]?.$2 ?? await db.getLyricsTranslation(key);
+      result = response?.lyrics;
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+    }
+
+    // 2. API.
+
+    // NOTE: We want to hit the API even if cache already had it (to refresh).
+
+    if (!_translationsRefreshed.contains(id)) {
+      debugPrint('LyricsResolver: _resolveTranslation: API: ${playable.uri}');
+      try {
+        final lyricsTranslationGet = LyricsTranslationGet();
+        final response = await lyricsTranslationGet.call(
+          lyrics,
+          '${language.name} (${language.code})',
+          key.track,
+          key.artist,
+          key.duration,
+        );
+        if (response != null) {
+          if (response.same) {
+            result = [];
+            _translationWrites[id] = (key, response);
+            _scheduleFlush();
+          } else if (response.lyrics != null && response.lyrics?.length == lyrics.length) {
+            result = response.lyrics;
+            _translationWrites[id] = (key, response);
+            _scheduleFlush();
+          }
+          _translationsRefreshed.add(id);
+        }
+      } catch (exception, stacktrace) {
+        debugPrint(exception.toString());
+        debugPrint(stacktrace.toString());
+      }
+    }
+
+    return result;
+  }
+
+  void _scheduleFlush() {
+    if (_lyricsWrites.length + _translationWrites.length >= kBatchSize) {
+      unawaited(flush());
+      return;
+    }
+    _flushTimer ??= Timer(kFlushInterval, flush);
+  }
+
+  /// In-flight lyrics resolutions by track & artist.
+  final HashMap<(String, String), Future<Lyrics?>> _lyricsRequests = HashMap<(String, String), Future<Lyrics?>>();
+
+  /// In-flight translation resolutions by track, artist & language.
+  final HashMap<(String, String, String), Future<Lyrics?>> _translationRequests = HashMap<(String, String, String), Future<Lyrics?>>();
+
+  /// Translations refreshed from the API in this session.
+  final HashSet<(String, String, String)> _translationsRefreshed = HashSet<(String, String, String)>();
+
+  /// Lyrics pending to be written to the database.
+  final HashMap<(String, String), (LyricsKey, Lyrics)> _lyricsWrites = HashMap<(String, String), (LyricsKey, Lyrics)>();
+
+  /// Translations pending to be written to the database.
+  final HashMap<(String, String, String), (LyricsTranslationKey, LyricsTranslation)> _translationWrites = HashMap<(String, String, String), (LyricsTranslationKey, LyricsTranslation)>();
+
+  /// Entries pending to be prefetched.
+  final ListQueue<(Playable, Duration)> _queue = ListQueue<(Playable, Duration)>();
+
+  /// Translation language of the entries pending to be prefetched.
+  Language? _language;
+
+  /// Number of running prefetch workers.
+  int _workers = 0;
+
+  Timer? _flushTimer;
+}
@@ -76,6 +76,9 @@ class MaterialWaveSlider extends StatefulWidget {
   /// The width of the default thumb.
   final double thumbWidth;
 
+  /// Normalized (0.0 to 1.0) peaks of the audio. If provided, these are drawn instead of the wave.
+  final List<double>? peaks;
+
   // --------------------------------------------------
 
   /// {@macro material_wave_slider}
@@ -94,6 +97,7 @@ class MaterialWaveSlider extends StatefulWidget {
     this.transitionOnChange = true,
     this.thumbBuilder,
     this.thumbWidth = 6.0,
+    this.peaks,
   });
 
   @override
@@ -115,6 +119,9 @@ class MaterialWaveSliderState extends State<MaterialWaveSlider> with SingleTicke
   @override
   void didUpdateWidget(covariant MaterialWaveSlider oldWidget) {
     super.didUpdateWidget(oldWidget);
+    if (oldWidget.peaks != null && widget.peaks == null) {
+      WidgetsBinding.instance.addPostFrameCallback((_) => _animate());
+    }
     if (_current == null) {
       if (widget.paused) {
         pause();
@@ -174,16 +181,20 @@ class MaterialWaveSliderState extends State<MaterialWaveSlider> with SingleTicke
   @override
   void initState() {
     super.initState();
-    WidgetsBinding.instance.addPostFrameCallback((timeStamp) {
-      const multiplier = 1 << 32;
-      final distance = widget.height * multiplier;
-      final duration = widget.velocity * multiplier;
-      _controller.animateTo(
-        distance,
-        duration: Duration(milliseconds: duration.round()),
-        curve: Curves.linear,
-      );
-    });
+    WidgetsBinding.instance.addPostFrameCallback((_) => _animate());
+  }
+
+  void _animate() {
+    // NOTE: The wave is not laid out when [MaterialWaveSlider.peaks] are provided.
+    if (!mounted || !_controller.hasClients) return;
+    const multiplier = 1 << 32;
+    final distance = widget.height * multiplier;
+    final duration = widget.velocity * multiplier;
+    _controller.animateTo(
+      distance,
+      duration: Duration(milliseconds: duration.round()),
+      curve: Curves.linear,
+    );
   }
 
   @override
@@ -248,52 +259,74 @@ class MaterialWaveSliderState extends State<MaterialWaveSlider> with SingleTicke
               child: Stack(
                 alignment: Alignment.center,
                 children: [
-                  ClipRect(
-                    clipper: RectClipper(_percent),
-                    child: SizedBox(
-                      width: constraints.maxWidth,
-                      height: widget.height,
-                      child: ListView.builder(
-                        controller: _controller,
-                        itemExtent: widget.height,
-                        padding: EdgeInsets.zero,
-                        scrollDirection: Axis.horizontal,
-                        physics: const NeverScrollableScrollPhysics(),
-                        itemBuilder: (context, _) => TweenAnimationBuilder<double>(
-                          tween: Tween<double>(
-                            begin: _running ? _amplitude : 0.0,
-                            end: _running ? _amplitude : 0.0,
+                  if (widget.peaks != null) ...[
+                    CustomPaint(
+                      painter: PeaksPainter(
+                        color: sliderTheme.inactiveTrackColor!,
+                        peaks: widget.peaks!,
+                        strokeWidth: sliderTheme.trackHeight!,
+                      ),
+                      size: Size(constraints.maxWidth, widget.height),
+                    ),
+                    ClipRect(
+                      clipper: RectClipper(_percent),
+                      child: CustomPaint(
+                        painter: PeaksPainter(
+                          color: sliderTheme.activeTrackColor!,
+                          peaks: widget.peaks!,
+                          strokeWidth: sliderTheme.trackHeight!,
+                        ),
+                        size: Size(constraints.maxWidth, widget.height),
+                      ),
+                    ),
+                  ] else ...[
+                    ClipRect(
+                      clipper: RectClipper(_percent),
+                      child: SizedBox(
+                        width: constraints.maxWidth,
+                        height: widget.height,
+                        child: ListView.builder(
+                          controller: _controller,
+                          itemExtent: widget.height,
+                          padding: EdgeInsets.zero,
+                          scrollDirection: Axis.horizontal,
+                          physics: const NeverScrollableScrollPhysics(),
+                          itemBuilder: (context, _) => TweenAnimationBuilder<double>(
+                            tween: Tween<double>(
+                              begin: _running ? _amplitude : 0.0,
+                              end: _running ? _amplitude : 0.0,
+                            ),
+                            curve: widget.transitionCurve,
+                            duration: widget.transitionDuration,
+                            builder: (context, value, _) {
+                              if (value == _amplitude) {
+                                return _defaultPaint!;
+                              }
+                              return CustomPaint(
+                                key: ValueKey(value),
+                                painter: SinePainter(
+                                  color: sliderTheme.activeTrackColor!,
+                                  delta: widget.height / 25.0,
+                                  phase: 0.0,
+                                  amplitude: value,
+                                  strokeWidth: sliderTheme.trackHeight!,
+                                ),
+                                size: Size(widget.height, widget.height),
+                              );
+                            },
                           ),
-                          curve: widget.transitionCurve,
-                          duration: widget.transitionDuration,
-                          builder: (context, value, _) {
-                            if (value == _amplitude) {
-                              return _defaultPaint!;
-                            }
-                            return CustomPaint(
-                              key: ValueKey(value),
-                              painter: SinePainter(
-                                color: sliderTheme.activeTrackColor!,
-                                delta: widget.height / 25.0,
-                                phase: 0.0,
-                                amplitude: value,
-                                strokeWidth: sliderTheme.trackHeight!,
-                              ),
-                              size: Size(widget.height, widget.height),
-                            );
-                          },
                         ),
                       ),
                     ),
-                  ),
-                  Positioned(
-                    left: constraints.maxWidth * _percent - widget.thumbWidth / 2.0,
-                    right: 0.0,
-                    child: Container(
-                      color: sliderTheme.inactiveTrackColor!,
-                      height: sliderTheme.trackHeight!,
+                    Positioned(
+                      left: constraints.maxWidth * _percent - widget.thumbWidth / 2.0,
+                      right: 0.0,
+                      child: Container(
+                        color: sliderTheme.inactiveTrackColor!,
+                        height: sliderTheme.trackHeight!,
+                      ),
                     ),
-                  ),
+                  ],
                   Positioned(
                     left: (constraints.maxWidth * _percent - widget.thumbWidth / 3.0).limit(constraints.maxWidth * _percent - widget.thumbWidth),
                     child:
@@ -392,6 +425,64 @@ class SinePainter extends CustomPainter {
   }
 }
 
+/// {@template peaks_painter}
+///
+/// PeaksPainter
+/// ------------
+/// A [CustomPainter] to draw the peaks of the audio as vertical bars.
+///
+/// {@endtemplate}
+class PeaksPainter extends CustomPainter {
+  /// The color of the bars.
+  final Color color;
+
+  /// Normalized (0.0 to 1.0) peaks of the audio.
+  final List<double> peaks;
+
+  /// The stroke-width of the bars.
+  final double strokeWidth;
+
+  /// {@macro peaks_painter}
+  PeaksPainter({
+    required this.color,
+    required this.peaks,
+    this.strokeWidth = 2.0,
+  });
+
+  @override
+  void paint(Canvas canvas, Size size) {
+    if (peaks.isEmpty) return;
+    final paint = Paint()
+      ..color = color
+      ..strokeCap = StrokeCap.round
+      ..strokeWidth = strokeWidth
+      ..style = PaintingStyle.stroke;
+
+    // Draw one bar per (strokeWidth * 2.0) pixels, picking the maximum of the peaks that fall within.
+    final count = max(1, size.width ~/ (strokeWidth * 2.0));
+    final path = Path();
+    for (var i = 0; i < count; i++) {
+      final start = i * peaks.length ~/ count;
+      final end = max(start + 1, (i + 1) * peaks.length ~/ count);
+      var peak = 0.0;
+      for (var j = start; j < end && j < peaks.length; j++) {
+        peak = max(peak, peaks[j]);
+      }
+      final x = (i + 0.5) * size.width / count;
+      final y = max(strokeWidth / 2.0, peak.clamp(0.0, 1.0) * (size.height - strokeWidth) / 2.0);
+      path.moveTo(x, size.height / 2.0 - y);
+      path.lineTo(x, size.height / 2.0 + y);
+    }
+    canvas.drawPath(path, paint);
+  }
+
+  @override
+  bool shouldRepaint(CustomPainter oldDelegate) {
+    final previous = (oldDelegate as PeaksPainter);
+    return color != previous.color || peaks != previous.peaks || strokeWidth != previous.strokeWidth;
+  }
+}
+
 /// {@template rect_clipper}
 ///
 /// RectClipper
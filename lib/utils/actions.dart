@@ -91,6 +91,12 @@ void mediaPlayerUpdateCurrentOnUpdateCurrent(String uri) {
   }
 }
 
+void mediaPlayerUpdateCurrentOnPrefetch(String uri) {
+  if (rootNavigatorKey.currentContext == null) return;
+  // Resolve the cover file ahead of time, it is then available synchronously once the track starts playing.
+  cover(uri: uri).obtainKey(ImageConfiguration.empty).ignore();
+}
+
 void mediaPlayerSetExclusiveAudioOnError() {
   debugPrint('actions.dart: mediaPlayerSetExclusiveAudioOnError');
   showMessage(
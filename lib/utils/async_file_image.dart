@@ -10,6 +10,10 @@ import 'package:flutter/rendering.dart';
 import 'package:safe_local_storage/safe_local_storage.dart';
 import 'package:synchronized/synchronized.dart';
 
+import 'package:harmonoid/core/cover_store.dart';
+import 'package:harmonoid/utils/palette_cache.dart';
+import 'package:harmonoid/utils/thumbnail_cache.dart';
+
 /// {@template async_file_image}
 ///
 /// AsyncFileImage
@@ -23,8 +27,9 @@ class AsyncFileImage extends ImageProvider<AsyncFileImageKey> {
   const AsyncFileImage(
     this.key,
     this.getFile,
-    this.getFallbackFile,
-  );
+    this.getFallbackFile, {
+    this.size,
+  });
 
   final String key;
 
@@ -32,6 +37,9 @@ class AsyncFileImage extends ImageProvider<AsyncFileImageKey> {
 
   final Future<File> Function() getFallbackFile;
 
+  /// Largest dimension (in physical pixels) the image is displayed at. If specified, a pre-scaled thumbnail is loaded from [ThumbnailCache].
+  final int? size;
+
   final double scale = 1.0;
 
   @override
@@ -81,6 +89,8 @@ class AsyncFileImage extends ImageProvider<AsyncFileImageKey> {
         throw StateError('$key is empty and cannot be loaded as an image.');
       }
 
+      await CoverStore.instance.identify(instance);
+
       files[key] = instance;
       fallbacks[key] = result == null;
       return instance;
@@ -88,16 +98,20 @@ class AsyncFileImage extends ImageProvider<AsyncFileImageKey> {
   }
 
   AsyncFileImageKey _toCacheKey(File file) {
+    // Tracks sharing the same cover (e.g. of an album) resolve to the same key, so the image is decoded once.
+    final identity = CoverStore.instance.lookup(file);
     return AsyncFileImageKey(
-      key: key,
+      key: identity == null ? key : 'CoverStore:$identity',
       file: file,
       scale: scale,
-      generation: generations[key] ?? 0,
+      size: size == null ? null : ThumbnailCache.sizeFor(size!),
+      generation: identity == null ? generations[key] ?? 0 : 0,
     );
   }
 
   Future<ui.Codec> _loadAsync(AsyncFileImageKey key, {required _SimpleDecoderCallback decode}) async {
-    return decode(await ui.ImmutableBuffer.fromFilePath(key.file.path));
+    final file = key.size == null ? key.file : await ThumbnailCache.instance.obtain(key.file, key.size!, identity: CoverStore.instance.lookup(key.file));
+    return decode(await ui.ImmutableBuffer.fromFilePath(file.path));
   }
 
   Future<T?> _resolve<T>(FutureOr<T?> future) async {
@@ -131,6 +145,7 @@ class AsyncFileImage extends ImageProvider<AsyncFileImageKey> {
     fileLocks.clear();
     fallbacks.clear();
     generations.clear();
+    ThumbnailCache.instance.clear();
     // DO NOT RESET THE COUNT; PREVENT ENDLESS ATTEMPTS.
     // attemptToResolveIfFallbackCounts.clear();
     attemptToResolveIfFallbackTimestamps.clear();
@@ -138,7 +153,12 @@ class AsyncFileImage extends ImageProvider<AsyncFileImageKey> {
   }
 
   static void reset(String key) {
-    files.remove(key);
+    final file = files.remove(key);
+    if (file != null) {
+      ThumbnailCache.instance.evict(file, identity: CoverStore.instance.lookup(file));
+      PaletteCache.instance.evict(file, identity: CoverStore.instance.lookup(file));
+      CoverStore.instance.evict(file);
+    }
     fileLocks.remove(key);
     fallbacks.remove(key);
     generations[key] = (generations[key] ?? 0) + 1;
@@ -184,22 +204,26 @@ class AsyncFileImageKey {
     required this.key,
     required this.file,
     required this.scale,
+    required this.size,
     required this.generation,
   });
 
   final String key;
 
+  /// Not part of the equality; [generation] changes whenever the file of [key] changes.
   final File file;
 
   final double scale;
 
+  final int? size;
+
   final int generation;
 
   @override
   bool operator ==(Object other) {
-    return other is AsyncFileImageKey && other.key == key && other.file.path == file.path && other.scale == scale && other.generation == generation;
+    return other is AsyncFileImageKey && other.key == key && other.scale == scale && other.size == size && other.generation == generation;
   }
 
   @override
-  int get hashCode => Object.hash(key, file.path, scale, generation);
+  int get hashCode => Object.hash(key, scale, size, generation);
 }
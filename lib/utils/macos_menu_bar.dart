@@ -5,6 +5,7 @@ import 'package:flutter/widgets.dart';
 import 'package:media_library/media_library.dart';
 import 'package:provider/provider.dart';
 
+import 'package:harmonoid/core/media_library_watcher.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/routing/router.dart';
 import 'package:harmonoid/routing/utils/constants.dart';
@@ -51,7 +52,7 @@ class MacOSMenuBar extends StatelessWidget {
                 PlatformMenuItem(
                   label: Localization.instance.REFRESH,
                   onSelected: () {
-                    context.read<MediaLibrary>().refresh();
+                    context.read<MediaLibrary>().refresh().then((_) => MediaLibraryWatcher.instance.seed());
                   },
                 ),
               ],
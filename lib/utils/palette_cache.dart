@@ -0,0 +1,165 @@
+import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:math';
+import 'dart:typed_data';
+import 'package:crypto/crypto.dart';
+import 'package:flutter/painting.dart';
+import 'package:image/image.dart' as img;
+import 'package:path/path.dart';
+import 'package:safe_local_storage/safe_local_storage.dart';
+
+import 'package:harmonoid/third_party/palette_generator.dart';
+
+/// {@template palette_cache}
+///
+/// PaletteCache
+/// ------------
+/// Implementation to extract, persist & retrieve color palettes of cover images.
+///
+/// Extraction (decode, resize & quantize) runs on a separate isolate. The result is persisted as a list of ARGB values, so each cover is
+/// only processed once. Sources with the same identity (e.g. content hash) share a single palette.
+///
+/// {@endtemplate}
+class PaletteCache {
+  /// Dimension (in pixels) the cover is resized to before quantization.
+  static const int kDimension = 40;
+
+  /// Number of palettes extracted on a single isolate by [precompute].
+  static const int kBatchSize = 16;
+
+  /// Singleton instance.
+  static final PaletteCache instance = PaletteCache._();
+
+  /// Whether the [instance] is initialized.
+  static bool initialized = false;
+
+  /// {@macro palette_cache}
+  PaletteCache._();
+
+  /// Initializes the [instance].
+  static Future<void> ensureInitialized({required Directory directory}) async {
+    if (initialized) return;
+    initialized = true;
+    instance._directory = directory;
+    if (!await directory.exists_()) {
+      await directory.create_();
+    }
+  }
+
+  /// Returns the color palette of [source] from the cache, without extracting it.
+  Future<List<Color>?> lookup(File source, {String? identity}) async {
+    final key = identity ?? source.path;
+    final result = _palettes[key];
+    if (result != null) return result;
+    try {
+      final file = _fileFor(key);
+      final sourceStat = await source.stat();
+      final fileStat = await file.stat();
+      if (fileStat.type != FileSystemEntityType.file || fileStat.modified.isBefore(sourceStat.modified)) {
+        return null;
+      }
+      final data = ByteData.sublistView(await file.readAsBytes());
+      final palette = [for (var i = 0; i < data.lengthInBytes ~/ 4; i++) Color(data.getUint32(i * 4, Endian.little))];
+      return _palettes[key] = palette;
+    } catch (_) {
+      return null;
+    }
+  }
+
+  /// Returns the color palette of [source]. Extracts & persists it if not present in the cache.
+  Future<List<Color>?> obtain(File source, {String? identity}) async {
+    final key = identity ?? source.path;
+    final result = await lookup(source, identity: identity);
+    if (result != null) return result;
+    return _pending[key] ??= _extract(source, key).whenComplete(() => _pending.remove(key));
+  }
+
+  /// Extracts & persists the color palettes of [sources] (source & identity) not present in the cache, [kBatchSize] at a time on a single
+  /// isolate. Stops once [cancel] returns true.
+  Future<void> precompute(List<(File, String?)> sources, {bool Function()? cancel}) async {
+    final keys = HashSet<String>();
+    final missing = <(File, String)>[];
+    for (final (source, identity) in sources) {
+      final key = identity ?? source.path;
+      if (!keys.add(key) || _pending.containsKey(key)) continue;
+      if (await lookup(source, identity: identity) != null) continue;
+      missing.add((source, key));
+    }
+    for (var i = 0; i < missing.length; i += kBatchSize) {
+      if (cancel?.call() ?? false) break;
+      final batch = missing.sublist(i, min(i + kBatchSize, missing.length));
+      final paths = batch.map((e) => e.$1.path).toList();
+      final results = await Isolate.run(() => _extractPalettes(paths));
+      for (var j = 0; j < batch.length; j++) {
+        final values = results[j];
+        if (values == null) continue;
+        await _store(batch[j].$2, values);
+      }
+    }
+  }
+
+  /// Evicts the in-memory lookup of [source].
+  void evict(File source, {String? identity}) {
+    _palettes.remove(identity ?? source.path);
+  }
+
+  Future<List<Color>?> _extract(File source, String key) async {
+    final path = source.path;
+    final values = await Isolate.run(() => _extractPalette(path));
+    if (values == null) return null;
+    return _store(key, values);
+  }
+
+  Future<List<Color>> _store(String key, List<int> values) async {
+    final data = ByteData(values.length * 4);
+    for (var i = 0; i < values.length; i++) {
+      data.setUint32(i * 4, values[i], Endian.little);
+    }
+    await _fileFor(key).write_(data.buffer.asUint8List());
+
+    return _palettes[key] = values.map(Color.new).toList();
+  }
+
+  File _fileFor(String key) => File(join(_directory.path, '${sha256.convert(utf8.encode(key))}.PAL'));
+
+  /// Directory where palettes are stored.
+  late final Directory _directory;
+
+  /// Resolved palettes keyed by source identity.
+  final HashMap<String, List<Color>> _palettes = HashMap<String, List<Color>>();
+
+  /// Palettes being extracted keyed by source identity.
+  final HashMap<String, Future<List<Color>?>> _pending = HashMap<String, Future<List<Color>?>>();
+}
+
+/// Runs inside a separate isolate.
+Future<List<List<int>?>> _extractPalettes(List<String> paths) async {
+  final result = <List<int>?>[];
+  for (final path in paths) {
+    try {
+      result.add(await _extractPalette(path));
+    } catch (_) {
+      result.add(null);
+    }
+  }
+  return result;
+}
+
+/// Runs inside a separate isolate.
+Future<List<int>?> _extractPalette(String path) async {
+  final image = await img.decodeImageFile(path);
+  if (image == null) return null;
+  final resized = img.copyResize(image, width: PaletteCache.kDimension, height: PaletteCache.kDimension, interpolation: img.Interpolation.average);
+  final bytes = resized.convert(format: img.Format.uint8, numChannels: 4, alpha: 255).getBytes(order: img.ChannelOrder.rgba);
+  final result = await PaletteGenerator.fromByteData(
+    EncodedImage(
+      ByteData.sublistView(bytes),
+      width: resized.width,
+      height: resized.height,
+    ),
+  );
+  return result.colors?.map((e) => e.toARGB32()).toList();
+}
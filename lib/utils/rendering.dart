@@ -1,6 +1,7 @@
 import 'dart:async';
 import 'dart:io';
 import 'package:adaptive_layouts/adaptive_layouts.dart';
+import 'package:collection/collection.dart';
 import 'package:file_picker/file_picker.dart';
 import 'package:flutter/material.dart';
 import 'package:flutter/services.dart';
@@ -170,7 +171,9 @@ ImageProvider cover({
     },
   );
 
-  final image = AsyncFileImage(key, getFile, getFallbackFile);
+  final size = [cacheWidth, cacheHeight].nonNulls.maxOrNull;
+
+  final image = AsyncFileImage(key, getFile, getFallbackFile, size: size);
 
   if (cacheWidth != null || cacheHeight != null) {
     return ResizeImage.resizeIfNeeded(cacheWidth, cacheHeight, image);
@@ -0,0 +1,128 @@
+import 'dart:async';
+import 'dart:convert';
+import 'dart:io';
+import 'package:flutter/widgets.dart';
+import 'package:path/path.dart';
+
+/// {@template startup_trace}
+///
+/// StartupTrace
+/// ------------
+/// Implementation to trace the startup of the application, from the native entry point to the first frame after splash.
+///
+/// Enabled by setting the [kEnvironmentVariable] environment variable to the path of the output file (or 1 for a file in the temporary
+/// directory). The output is in Chrome trace event format, which may be opened in chrome://tracing or https://ui.perfetto.dev. A summary
+/// table is printed once the trace is written.
+///
+/// The native runner (currently Linux) passes its timestamps through the [kNativeEnvironmentVariable] environment variable as
+/// `name=microseconds;...` entries, measured on the same (wall) clock. Since the environment is only read once, only the timestamps
+/// before the Flutter engine is started are available.
+///
+/// {@endtemplate}
+class StartupTrace {
+  static const String kEnvironmentVariable = 'HARMONOID_STARTUP_TRACE';
+  static const String kNativeEnvironmentVariable = 'HARMONOID_STARTUP_TRACE_NATIVE';
+
+  /// Singleton instance.
+  static final StartupTrace instance = StartupTrace._();
+
+  /// {@macro startup_trace}
+  StartupTrace._() : _start = DateTime.now().microsecondsSinceEpoch;
+
+  /// Whether tracing is enabled.
+  bool get enabled => _path != null;
+
+  /// Runs [action] as a span named [name].
+  Future<T> span<T>(String name, FutureOr<T> Function() action) async {
+    if (!enabled || _finished) return action();
+    final start = DateTime.now().microsecondsSinceEpoch;
+    try {
+      return await action();
+    } finally {
+      _events.add(_Event(name, 'dart', start, DateTime.now().microsecondsSinceEpoch - start));
+    }
+  }
+
+  /// Waits for the next frame to be rasterized, then writes the trace & prints the summary.
+  Future<void> finish() async {
+    if (!enabled || _finished) return;
+    _finished = true;
+    try {
+      final start = DateTime.now().microsecondsSinceEpoch;
+      await WidgetsBinding.instance.endOfFrame;
+      _events.add(_Event('First Frame', 'dart', start, DateTime.now().microsecondsSinceEpoch - start));
+
+      final events = [..._native(), _Event('Dart Entry Point', 'dart', _start, 0), ..._events];
+      final origin = events.map((e) => e.start).reduce((a, b) => a < b ? a : b);
+
+      final file = File(_path == '1' || _path!.isEmpty ? join(Directory.systemTemp.path, 'Harmonoid-StartupTrace-$pid.json') : _path!);
+      await file.writeAsString(
+        jsonEncode({
+          'displayTimeUnit': 'ms',
+          'traceEvents': [
+            for (final e in events)
+              {
+                'name': e.name,
+                'cat': e.category,
+                'ph': e.duration == 0 ? 'i' : 'X',
+                'ts': e.start - origin,
+                if (e.duration != 0) 'dur': e.duration,
+                if (e.duration == 0) 's': 'p',
+                'pid': pid,
+                'tid': e.category == 'native' ? 0 : 1,
+              },
+          ],
+        }),
+      );
+
+      final buffer = StringBuffer();
+      buffer.writeln('StartupTrace: ${file.path}');
+      buffer.writeln('${'Name'.padRight(40)}${'Start (ms)'.padLeft(12)}${'Duration (ms)'.padLeft(16)}');
+      for (final e in events) {
+        buffer.writeln('${e.name.padRight(40)}${((e.start - origin) / 1000.0).toStringAsFixed(1).padLeft(12)}${(e.duration / 1000.0).toStringAsFixed(1).padLeft(16)}');
+      }
+      buffer.write('${'Total'.padRight(40)}${''.padLeft(12)}${((events.map((e) => e.end).reduce((a, b) => a > b ? a : b) - origin) / 1000.0).toStringAsFixed(1).padLeft(16)}');
+      debugPrint(buffer.toString());
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+    }
+  }
+
+  /// Native timestamps as consecutive spans; each one ends at its own timestamp & begins at the previous one.
+  List<_Event> _native() {
+    final result = <_Event>[];
+    final entries = (Platform.environment[kNativeEnvironmentVariable] ?? '').split(';').map((e) => e.split('=')).where((e) => e.length == 2);
+    int? previous;
+    for (final entry in entries) {
+      final timestamp = int.tryParse(entry[1]);
+      if (timestamp == null) continue;
+      result.add(_Event(entry[0], 'native', previous ?? timestamp, previous == null ? 0 : timestamp - previous));
+      previous = timestamp;
+    }
+    return result;
+  }
+
+  /// Timestamp (in microseconds) at which the Dart entry point started.
+  final int _start;
+
+  /// Output file path.
+  final String? _path = Platform.environment[kEnvironmentVariable];
+
+  /// Recorded events.
+  final List<_Event> _events = <_Event>[];
+
+  /// Whether [finish] has been invoked.
+  bool _finished = false;
+}
+
+class _Event {
+  final String name;
+  final String category;
+  final int start;
+  final int duration;
+
+  int get end => start + duration;
+
+  const _Event(this.name, this.category, this.start, this.duration);
+}
@@ -0,0 +1,36 @@
+import 'dart:collection';
+
+/// {@template string_interner}
+///
+/// StringInterner
+/// --------------
+/// Implementation to de-duplicate equal [String]s, so that each unique value is held in memory once.
+///
+/// Tag values (e.g. album, artist & genre names) repeat across thousands of tracks; without interning, every track retains a separate
+/// copy of the same value.
+///
+/// {@endtemplate}
+class StringInterner {
+  /// {@macro string_interner}
+  StringInterner();
+
+  /// Number of unique values.
+  int get length => _values.length;
+
+  /// Returns the canonical instance equal to [value].
+  String call(String value) {
+    final result = _values.lookup(value);
+    if (result != null) return result;
+    _values.add(value);
+    return value;
+  }
+
+  /// Returns the canonical instances equal to the values in [values].
+  Set<String> all(Iterable<String> values) => {for (final value in values) call(value)};
+
+  /// Releases all the values.
+  void clear() => _values.clear();
+
+  /// Unique values.
+  final HashSet<String> _values = HashSet<String>();
+}
@@ -0,0 +1,163 @@
+import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:math';
+import 'package:crypto/crypto.dart';
+import 'package:flutter/foundation.dart';
+import 'package:image/image.dart' as img;
+import 'package:path/path.dart';
+import 'package:pool/pool.dart';
+import 'package:safe_local_storage/safe_local_storage.dart';
+
+/// {@template thumbnail_cache}
+///
+/// ThumbnailCache
+/// --------------
+/// Implementation to store pre-scaled copies of cover images at a few fixed sizes.
+///
+/// Each cover is decoded & downscaled (longest side) once per size, on a background thread. Loading a thumbnail afterwards only decodes a
+/// small JPEG (or PNG, if the cover has transparency). Covers not exceeding the size are used as-is. Thumbnails not used for [kRetention]
+/// are deleted.
+///
+/// {@endtemplate}
+class ThumbnailCache {
+  /// Available sizes (in physical pixels): list tiles, grid items, now playing.
+  static const List<int> kSizes = [128, 256, 512];
+  static const int kQuality = 90;
+
+  /// Duration after which unused thumbnails (e.g. of removed covers) are deleted.
+  static const Duration kRetention = Duration(days: 30);
+
+  /// Singleton instance.
+  static final ThumbnailCache instance = ThumbnailCache._();
+
+  /// Whether the [instance] is initialized.
+  static bool initialized = false;
+
+  /// {@macro thumbnail_cache}
+  ThumbnailCache._();
+
+  /// Initializes the [instance].
+  static Future<void> ensureInitialized({required Directory directory}) async {
+    if (initialized) return;
+    initialized = true;
+    instance._directory = directory;
+    for (final size in kSizes) {
+      final child = Directory(join(directory.path, '$size'));
+      if (!await child.exists_()) {
+        await child.create_();
+      }
+    }
+    final path = directory.path;
+    unawaited(Isolate.run(() => _prune(path)));
+  }
+
+  /// Returns the smallest available size that covers [dimension], or null if [dimension] exceeds every available size.
+  static int? sizeFor(int dimension) {
+    for (final size in kSizes) {
+      if (size >= dimension) return size;
+    }
+    return null;
+  }
+
+  /// Returns the thumbnail of [source] at [size]. Returns [source] itself if the thumbnail cannot be created.
+  ///
+  /// Sources with the same [identity] (e.g. content hash) share a single thumbnail.
+  Future<File> obtain(File source, int size, {String? identity}) {
+    if (!initialized) return Future.value(source);
+    final key = '$size-${identity ?? source.path}';
+    final result = _files[key];
+    if (result != null) return Future.value(result);
+    return _pending[key] ??= _obtain(source, size, identity ?? source.path).then((value) {
+      _files[key] = value;
+      return value;
+    }).whenComplete(() => _pending.remove(key));
+  }
+
+  /// Evicts the in-memory lookups of [source]. Thumbnails on disk are validated against the modified time of the source.
+  void evict(File source, {String? identity}) {
+    for (final size in kSizes) {
+      _files.remove('$size-${identity ?? source.path}');
+    }
+  }
+
+  /// Evicts all the in-memory lookups. Thumbnails on disk are validated against the modified time of the source.
+  void clear() {
+    _files.clear();
+  }
+
+  Future<File> _obtain(File source, int size, String identity) async {
+    try {
+      // NOTE: An empty thumbnail marks a source which does not exceed [size] i.e. is used as-is.
+      final thumbnail = File(join(_directory.path, '$size', '${sha256.convert(utf8.encode(identity))}.IMG'));
+      final sourceStat = await source.stat();
+      final thumbnailStat = await thumbnail.stat();
+      if (thumbnailStat.type == FileSystemEntityType.file && !thumbnailStat.modified.isBefore(sourceStat.modified)) {
+        // Mark the thumbnail as used, see [_prune].
+        if (DateTime.now().difference(thumbnailStat.modified) > const Duration(days: 1)) {
+          await thumbnail.setLastModified(DateTime.now());
+        }
+        return thumbnailStat.size > 0 ? thumbnail : source;
+      }
+      return await _pool.withResource(() async {
+        final temp = File('${thumbnail.path}.tmp');
+        final path = source.path;
+        final resized = await Isolate.run(() => _resize(path, temp.path, size));
+        await temp.rename(thumbnail.path);
+        return resized ? thumbnail : source;
+      });
+    } catch (exception, stacktrace) {
+      debugPrint(exception.toString());
+      debugPrint(stacktrace.toString());
+      return source;
+    }
+  }
+
+  /// Directory where thumbnails are stored.
+  late final Directory _directory;
+
+  /// Resolved thumbnails keyed by size & source identity.
+  final HashMap<String, File> _files = HashMap<String, File>();
+
+  /// Thumbnails being created keyed by size & source identity.
+  final HashMap<String, Future<File>> _pending = HashMap<String, Future<File>>();
+
+  /// Pool used to limit the number of concurrent resize operations.
+  final Pool _pool = Pool(Platform.numberOfProcessors.clamp(1, 8));
+}
+
+/// Runs inside a separate isolate. Writes the thumbnail of [source] at [size] to [destination]. Returns false (& writes an empty file) if
+/// [source] does not exceed [size].
+Future<bool> _resize(String source, String destination, int size) async {
+  final image = await img.decodeImageFile(source);
+  if (image == null) throw Exception('ThumbnailCache: Unable to decode: $source');
+  if (max(image.width, image.height) <= size) {
+    await File(destination).writeAsBytes(const []);
+    return false;
+  }
+  final resized = image.width >= image.height
+      ? img.copyResize(image, width: size, interpolation: img.Interpolation.average)
+      : img.copyResize(image, height: size, interpolation: img.Interpolation.average);
+  // NOTE: JPEG drops the alpha channel.
+  final bytes = image.hasAlpha ? img.encodePng(resized) : img.encodeJpg(resized, quality: ThumbnailCache.kQuality);
+  await File(destination).writeAsBytes(bytes);
+  return true;
+}
+
+/// Runs inside a separate isolate. Deletes the thumbnails in [directory] not used for [ThumbnailCache.kRetention].
+void _prune(String directory) {
+  final threshold = DateTime.now().subtract(ThumbnailCache.kRetention);
+  for (final size in ThumbnailCache.kSizes) {
+    try {
+      for (final entity in Directory(join(directory, '$size')).listSync(followLinks: false)) {
+        try {
+          if (entity.statSync().modified.isBefore(threshold)) {
+            entity.deleteSync();
+          }
+        } catch (_) {}
+      }
+    } catch (_) {}
+  }
+}
@@ -7,9 +7,11 @@ import 'package:harmonoid/core/configuration/configuration.dart';
 import 'package:harmonoid/core/intent.dart';
 import 'package:harmonoid/core/filesystem_media_library.dart';
 import 'package:harmonoid/core/media_player/media_player.dart';
+import 'package:harmonoid/core/playback_history.dart';
 import 'package:harmonoid/localization/localization.dart';
 import 'package:harmonoid/mappers/media_player_state.dart';
 import 'package:harmonoid/routing/router.dart';
+import 'package:harmonoid/state/lyrics/lyrics_notifier.dart';
 import 'package:harmonoid/utils/rendering.dart';
 
 /// {@template window_lifecycle}
@@ -57,6 +59,21 @@ class WindowLifecycle {
           debugPrint(exception.toString());
           debugPrint(stacktrace.toString());
         }
+        try {
+          // NOTE: The buffered history must be written before the playlists are closed.
+          await PlaybackHistory.instance.flush();
+        } catch (exception, stacktrace) {
+          debugPrint(exception.toString());
+          debugPrint(stacktrace.toString());
+        }
+        try {
+          if (LyricsNotifier.initialized) {
+            await LyricsNotifier.instance.flush();
+          }
+        } catch (exception, stacktrace) {
+          debugPrint(exception.toString());
+          debugPrint(stacktrace.toString());
+        }
         try {
           await FileSystemMediaLibrary.instance.dispose();
         } catch (exception, stacktrace) {
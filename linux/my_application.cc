@@ -16,6 +16,24 @@ struct _MyApplication {
 
 G_DEFINE_TYPE(MyApplication, my_application, GTK_TYPE_APPLICATION)
 
+// Appends |name| & the current (wall) time in microseconds to the
+// HARMONOID_STARTUP_TRACE_NATIVE environment variable, which is read by
+// lib/utils/startup_trace.dart. Does nothing unless HARMONOID_STARTUP_TRACE is
+// set.
+//
+// Must only be called before the Flutter engine is started: the Dart VM reads
+// the environment once & g_setenv is not thread-safe.
+void my_application_trace(const gchar* name) {
+  if (g_getenv("HARMONOID_STARTUP_TRACE") == nullptr) {
+    return;
+  }
+  const gchar* previous = g_getenv("HARMONOID_STARTUP_TRACE_NATIVE");
+  g_autofree gchar* value = g_strdup_printf(
+      "%s%s%s=%" G_GINT64_FORMAT, previous != nullptr ? previous : "",
+      previous != nullptr ? ";" : "", name, g_get_real_time());
+  g_setenv("HARMONOID_STARTUP_TRACE_NATIVE", value, TRUE);
+}
+
 // Creates a new MyApplication instance, a new window is created with a new
 // Flutter engine & Dart entry point. The entry point arguments are taken from
 // MyApplication::dart_entrypoint_arguments & passed to the Dart entry point.
@@ -31,6 +49,7 @@ static void my_application_window_new(GApplication* application) {
     gtk_window_present(GTK_WINDOW(windows->data));
     return;
   }
+  my_application_trace("GApplication");
   // Create a new GtkWindow, Flutter engine & execute the Dart entry point.
   GtkWindow* window =
       GTK_WINDOW(gtk_application_window_new(GTK_APPLICATION(application)));
@@ -62,9 +81,11 @@ static void my_application_window_new(GApplication* application) {
     gtk_window_set_title(window, "Harmonoid");
   }
   gtk_widget_realize(GTK_WIDGET(window));
+  my_application_trace("GtkWindow");
   g_autoptr(FlDartProject) project = fl_dart_project_new();
   fl_dart_project_set_dart_entrypoint_arguments(
       project, self->dart_entrypoint_arguments);
+  my_application_trace("FlDartProject");
   FlView* view = fl_view_new(project);
   gtk_widget_realize(GTK_WIDGET(view));
   gtk_container_add(GTK_CONTAINER(window), GTK_WIDGET(view));
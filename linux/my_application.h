@@ -8,4 +8,7 @@ G_DECLARE_FINAL_TYPE(MyApplication, my_application, MY, APPLICATION,
 
 MyApplication* my_application_new();
 
+// Records a timestamp for the startup trace, if enabled.
+void my_application_trace(const gchar* name);
+
 #endif
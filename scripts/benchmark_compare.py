@@ -0,0 +1,56 @@
+import argparse
+import json
+import sys
+
+# Compares two results of lib/benchmark.dart & fails on regressions.
+#
+# Run:
+#   python3 scripts/benchmark_compare.py baseline.json current.json --threshold 10
+#
+# A measurement regresses if its median is more than --threshold percent (& --minimum ms) slower than in the baseline. The peak RSS
+# regresses if it is more than --rss-threshold percent higher. Exits with status 1 if anything regressed.
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two benchmark results.")
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0, help="allowed slowdown of the median (%%)")
+    parser.add_argument("--minimum", type=float, default=1.0, help="slowdowns below this (ms) are ignored as noise")
+    parser.add_argument("--rss-threshold", type=float, default=10.0, help="allowed increase of the peak RSS (%%)")
+    arguments = parser.parse_args()
+
+    with open(arguments.baseline) as file:
+        baseline = json.load(file)
+    with open(arguments.current) as file:
+        current = json.load(file)
+
+    if baseline.get("library") != current.get("library"):
+        print(f"warning: libraries differ: {baseline.get('library')} vs. {current.get('library')}", file=sys.stderr)
+
+    regressions = 0
+    print(f"{'Name':40}{'Baseline (ms)':>16}{'Current (ms)':>16}{'Change':>10}")
+    for name, result in current["results"].items():
+        previous = baseline["results"].get(name)
+        if previous is None:
+            print(f"{name:40}{'-':>16}{result['median_ms']:>16.2f}{'new':>10}")
+            continue
+        before, after = previous["median_ms"], result["median_ms"]
+        change = (after - before) / before * 100 if before > 0 else 0.0
+        regressed = change > arguments.threshold and after - before > arguments.minimum
+        regressions += regressed
+        print(f"{name:40}{before:>16.2f}{after:>16.2f}{change:>+9.1f}%{' REGRESSED' if regressed else ''}")
+
+    before, after = baseline["peak_rss_bytes"], current["peak_rss_bytes"]
+    change = (after - before) / before * 100 if before > 0 else 0.0
+    regressed = change > arguments.rss_threshold
+    regressions += regressed
+    print(f"{'peak_rss (MiB)':40}{before / 1024 / 1024:>16.1f}{after / 1024 / 1024:>16.1f}{change:>+9.1f}%{' REGRESSED' if regressed else ''}")
+
+    if regressions:
+        print(f"{regressions} regression(s).", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
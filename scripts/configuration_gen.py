@@ -35,7 +35,7 @@ def configuration_gen(json_data):
         set_method_content.append(
             f"""    if ({camel_case_key} != null) {{
       _{camel_case_key} = {camel_case_key};
-      await db.setValue(kKey{to_upper_camel_case(key)}, kType{item['serializedType']}, {item['serializedType'].lower()}Value: {value});
+      db.setValueDeferred(kKey{to_upper_camel_case(key)}, kType{item['serializedType']}, {item['serializedType'].lower()}Value: {value});
     }}"""
         )
         get_defaults_method_content.append(
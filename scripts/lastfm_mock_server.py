@@ -0,0 +1,137 @@
+import argparse
+import hashlib
+import json
+import random
+import re
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qsl
+
+# Local stand-in for the Last.fm track.scrobble endpoint.
+#
+# Run:
+#   python3 scripts/lastfm_mock_server.py --port 8080 --failure-rate 0.3
+# Then point the application to it:
+#   flutter run --dart-define=LASTFM_API_URL=http://127.0.0.1:8080/2.0/ --dart-define=LASTFM_SHARED_SECRET=secret ...
+#
+# Failed requests respond with Last.fm error 16 (temporarily unavailable), which the application retries with backoff.
+# A summary of throughput & accepted scrobbles is printed every --report-interval seconds.
+
+MAX_BATCH_SIZE = 50
+
+
+class Statistics:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.requests = 0
+        self.failures = 0
+        self.accepted = 0
+        self.duplicates = 0
+        self.batch_sizes = []
+        self.seen = set()
+
+    def report(self, elapsed):
+        with self.lock:
+            average = sum(self.batch_sizes) / len(self.batch_sizes) if self.batch_sizes else 0.0
+            print(
+                f"{elapsed:8.1f}s | requests: {self.requests} ({self.requests / elapsed:.2f}/s) | failures: {self.failures} | "
+                f"accepted: {self.accepted} ({self.accepted / elapsed:.2f}/s) | duplicates: {self.duplicates} | average batch: {average:.1f}",
+                flush=True,
+            )
+
+
+def signature(parameters, secret):
+    keys = sorted(k for k in parameters if k not in ("format", "callback", "api_sig"))
+    return hashlib.md5(("".join(k + parameters[k] for k in keys) + secret).encode("utf-8")).hexdigest()
+
+
+def handler(arguments, statistics):
+    class Handler(BaseHTTPRequestHandler):
+        def log_message(self, format, *args):
+            if arguments.verbose:
+                super().log_message(format, *args)
+
+        def respond(self, body, status=200):
+            data = json.dumps(body).encode("utf-8")
+            self.send_response(status)
+            self.send_header("Content-Type", "application/json")
+            self.send_header("Content-Length", str(len(data)))
+            self.end_headers()
+            self.wfile.write(data)
+
+        def do_POST(self):
+            length = int(self.headers.get("Content-Length", 0))
+            parameters = dict(parse_qsl(self.rfile.read(length).decode("utf-8"), keep_blank_values=True))
+
+            if arguments.latency > 0:
+                time.sleep(random.uniform(0, 2 * arguments.latency) / 1000)
+
+            with statistics.lock:
+                statistics.requests += 1
+
+            if random.random() < arguments.failure_rate:
+                with statistics.lock:
+                    statistics.failures += 1
+                return self.respond({"error": 16, "message": "There was a temporary error processing your request."})
+
+            if arguments.secret is not None and parameters.get("api_sig") != signature(parameters, arguments.secret):
+                return self.respond({"error": 13, "message": "Invalid method signature supplied"})
+
+            method = parameters.get("method")
+            if method == "track.updateNowPlaying":
+                return self.respond({"nowplaying": {}})
+            if method != "track.scrobble":
+                return self.respond({"error": 3, "message": "Invalid Method"})
+
+            indices = sorted({int(m.group(1)) for k in parameters for m in [re.fullmatch(r"track\[(\d+)\]", k)] if m})
+            if not indices or len(indices) > MAX_BATCH_SIZE:
+                return self.respond({"error": 6, "message": "Invalid parameters"})
+
+            scrobbles = []
+            with statistics.lock:
+                statistics.batch_sizes.append(len(indices))
+                for i in indices:
+                    key = (parameters.get(f"artist[{i}]"), parameters.get(f"track[{i}]"), parameters.get(f"timestamp[{i}]"))
+                    if key in statistics.seen:
+                        statistics.duplicates += 1
+                    statistics.seen.add(key)
+                    statistics.accepted += 1
+                    scrobbles.append({"artist": {"#text": key[0]}, "track": {"#text": key[1]}, "timestamp": key[2]})
+
+            self.respond({"scrobbles": {"@attr": {"accepted": len(indices), "ignored": 0}, "scrobble": scrobbles}})
+
+    return Handler
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Local stand-in for the Last.fm scrobbling API.")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--latency", type=float, default=0.0, help="average response latency (ms)")
+    parser.add_argument("--failure-rate", type=float, default=0.0, help="fraction of requests failing with error 16")
+    parser.add_argument("--secret", default=None, help="shared secret; if specified, api_sig is verified")
+    parser.add_argument("--report-interval", type=float, default=10.0)
+    parser.add_argument("--verbose", action="store_true")
+    arguments = parser.parse_args()
+
+    statistics = Statistics()
+    server = ThreadingHTTPServer((arguments.host, arguments.port), handler(arguments, statistics))
+    start = time.monotonic()
+
+    def report():
+        while True:
+            time.sleep(arguments.report_interval)
+            statistics.report(time.monotonic() - start)
+
+    threading.Thread(target=report, daemon=True).start()
+    print(f"Listening on http://{arguments.host}:{arguments.port}/2.0/", flush=True)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    statistics.report(time.monotonic() - start)
+
+
+if __name__ == "__main__":
+    main()
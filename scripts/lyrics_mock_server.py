@@ -0,0 +1,153 @@
+import argparse
+import json
+import random
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qsl, urlparse
+
+# Local stand-in for the lyrics-get & lyrics-translation endpoints.
+#
+# Run:
+#   python3 scripts/lyrics_mock_server.py --port 8082 --latency 800
+# Then point the application to it:
+#   flutter run --dart-define=API_BASE_URL=http://127.0.0.1:8082 ...
+# Translations are requested through the Supabase client, whose URL must point here as well to exercise them.
+#
+# Lyrics are generated from the request, so every track has some. A summary of requests, duplicate requests (same track & artist
+# requested more than once) & peak concurrency is printed every --report-interval seconds.
+
+LINES = 24
+
+
+class Statistics:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.requests = {"lyrics-get": 0, "lyrics-translation": 0}
+        self.duplicates = {"lyrics-get": 0, "lyrics-translation": 0}
+        self.failures = 0
+        self.concurrency = 0
+        self.peak_concurrency = 0
+        self.seen = set()
+
+    def begin(self, endpoint, key):
+        with self.lock:
+            self.requests[endpoint] += 1
+            if (endpoint, key) in self.seen:
+                self.duplicates[endpoint] += 1
+            self.seen.add((endpoint, key))
+            self.concurrency += 1
+            self.peak_concurrency = max(self.peak_concurrency, self.concurrency)
+
+    def end(self):
+        with self.lock:
+            self.concurrency -= 1
+
+    def report(self, elapsed):
+        with self.lock:
+            print(
+                f"{elapsed:8.1f}s | lyrics-get: {self.requests['lyrics-get']} (duplicates: {self.duplicates['lyrics-get']}) | "
+                f"lyrics-translation: {self.requests['lyrics-translation']} (duplicates: {self.duplicates['lyrics-translation']}) | "
+                f"failures: {self.failures} | peak concurrency: {self.peak_concurrency}",
+                flush=True,
+            )
+
+
+def lyrics(track, artist, duration):
+    step = max(int(duration) // (LINES + 1), 1000)
+    return [{"timestamp": (i + 1) * step, "text": f"{track} — {artist} ({i + 1}/{LINES})"} for i in range(LINES)]
+
+
+def handler(arguments, statistics):
+    class Handler(BaseHTTPRequestHandler):
+        def log_message(self, format, *args):
+            if arguments.verbose:
+                super().log_message(format, *args)
+
+        def respond(self, body, status=200):
+            data = json.dumps(body).encode("utf-8")
+            self.send_response(status)
+            self.send_header("Content-Type", "application/json")
+            self.send_header("Content-Length", str(len(data)))
+            self.end_headers()
+            self.wfile.write(data)
+
+        def delay(self):
+            if arguments.latency > 0:
+                time.sleep(random.uniform(0, 2 * arguments.latency) / 1000)
+
+        def fail(self):
+            if random.random() < arguments.failure_rate:
+                with statistics.lock:
+                    statistics.failures += 1
+                self.respond({"error": "Service unavailable"}, status=503)
+                return True
+            return False
+
+        def do_GET(self):
+            url = urlparse(self.path)
+            if url.path != "/functions/v1/lyrics-get":
+                return self.respond({"error": "Not found"}, status=404)
+            parameters = dict(parse_qsl(url.query, keep_blank_values=True))
+            track, artist = parameters.get("track", ""), parameters.get("artist", "")
+            statistics.begin("lyrics-get", (track, artist))
+            try:
+                self.delay()
+                if self.fail():
+                    return
+                if random.random() < arguments.missing_rate:
+                    return self.respond({"error": "Not found"}, status=404)
+                self.respond(lyrics(track, artist, parameters.get("duration", "0")))
+            finally:
+                statistics.end()
+
+        def do_POST(self):
+            url = urlparse(self.path)
+            if url.path != "/functions/v1/lyrics-translation":
+                return self.respond({"error": "Not found"}, status=404)
+            length = int(self.headers.get("Content-Length", 0))
+            body = json.loads(self.rfile.read(length).decode("utf-8") or "{}")
+            statistics.begin("lyrics-translation", (body.get("track"), body.get("artist"), body.get("language")))
+            try:
+                self.delay()
+                if self.fail():
+                    return
+                translated = [{"timestamp": e["timestamp"], "text": f"[{body.get('language')}] {e['text']}"} for e in body.get("lyrics", [])]
+                self.respond({"same": False, "lyrics": translated})
+            finally:
+                statistics.end()
+
+    return Handler
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Local stand-in for the lyrics API.")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8082)
+    parser.add_argument("--latency", type=float, default=0.0, help="average response latency (ms)")
+    parser.add_argument("--failure-rate", type=float, default=0.0, help="fraction of requests failing with HTTP 503")
+    parser.add_argument("--missing-rate", type=float, default=0.0, help="fraction of lyrics-get requests responding with HTTP 404")
+    parser.add_argument("--report-interval", type=float, default=10.0)
+    parser.add_argument("--verbose", action="store_true")
+    arguments = parser.parse_args()
+
+    statistics = Statistics()
+    server = ThreadingHTTPServer((arguments.host, arguments.port), handler(arguments, statistics))
+    start = time.monotonic()
+
+    def report():
+        while True:
+            time.sleep(arguments.report_interval)
+            statistics.report(time.monotonic() - start)
+
+    threading.Thread(target=report, daemon=True).start()
+    print(f"Listening on http://{arguments.host}:{arguments.port}/functions/v1/", flush=True)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    statistics.report(time.monotonic() - start)
+
+
+if __name__ == "__main__":
+    main()
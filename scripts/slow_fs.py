@@ -0,0 +1,98 @@
+import argparse
+import errno
+import os
+import threading
+import time
+
+# Read-only passthrough FUSE filesystem which adds latency & limits throughput, to simulate network storage (e.g. NFS/SMB on a busy NAS).
+#
+# Requires fusepy (pip install fusepy) & FUSE (libfuse2 on Linux, macFUSE on macOS).
+#
+# Run:
+#   python3 scripts/slow_fs.py ~/Music /tmp/SlowMusic --latency 200 --throughput 2048
+# Then add /tmp/SlowMusic to the media library & play a few tracks in a row.
+#
+# Every open waits for --latency ms & reads are throttled to --throughput KiB/s in total. Unmount with: fusermount -u /tmp/SlowMusic
+
+from fuse import FUSE, FuseOSError, Operations
+
+
+class SlowFS(Operations):
+    def __init__(self, root, latency, throughput):
+        self.root = os.path.realpath(root)
+        self.latency = latency / 1000
+        self.throughput = throughput * 1024
+        self.lock = threading.Lock()
+        # Time at which the shared link becomes available.
+        self.available = time.monotonic()
+
+    def path(self, partial):
+        return os.path.join(self.root, partial.lstrip("/"))
+
+    def throttle(self, size):
+        if self.throughput <= 0:
+            return
+        with self.lock:
+            start = max(time.monotonic(), self.available)
+            self.available = start + size / self.throughput
+            delay = self.available - time.monotonic()
+        if delay > 0:
+            time.sleep(delay)
+
+    def access(self, path, mode):
+        if mode & os.W_OK:
+            raise FuseOSError(errno.EROFS)
+        if not os.access(self.path(path), mode):
+            raise FuseOSError(errno.EACCES)
+
+    def getattr(self, path, fh=None):
+        st = os.lstat(self.path(path))
+        return {
+            key: getattr(st, key)
+            for key in ("st_atime", "st_ctime", "st_gid", "st_mode", "st_mtime", "st_nlink", "st_size", "st_uid")
+        }
+
+    def readdir(self, path, fh):
+        time.sleep(self.latency)
+        return [".", ".."] + os.listdir(self.path(path))
+
+    def readlink(self, path):
+        return os.readlink(self.path(path))
+
+    def statfs(self, path):
+        stv = os.statvfs(self.path(path))
+        return {
+            key: getattr(stv, key)
+            for key in ("f_bavail", "f_bfree", "f_blocks", "f_bsize", "f_favail", "f_ffree", "f_files", "f_flag", "f_frsize", "f_namemax")
+        }
+
+    def open(self, path, flags):
+        if flags & (os.O_WRONLY | os.O_RDWR):
+            raise FuseOSError(errno.EROFS)
+        time.sleep(self.latency)
+        return os.open(self.path(path), flags)
+
+    def read(self, path, size, offset, fh):
+        self.throttle(size)
+        return os.pread(fh, size, offset)
+
+    def release(self, path, fh):
+        return os.close(fh)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Read-only FUSE passthrough with simulated network latency.")
+    parser.add_argument("root", help="directory to expose")
+    parser.add_argument("mountpoint")
+    parser.add_argument("--latency", type=float, default=200.0, help="latency of open & readdir (ms)")
+    parser.add_argument("--throughput", type=float, default=2048.0, help="total read throughput (KiB/s); 0 for unlimited")
+    arguments = parser.parse_args()
+
+    os.makedirs(arguments.mountpoint, exist_ok=True)
+    print(f"Mounting {arguments.root} at {arguments.mountpoint}: latency {arguments.latency} ms, throughput {arguments.throughput} KiB/s", flush=True)
+    # direct_io: bypass the page cache, so that repeated reads stay slow.
+    FUSE(SlowFS(arguments.root, arguments.latency, arguments.throughput), arguments.mountpoint, foreground=True, ro=True, nothreads=False, direct_io=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,261 @@
+import argparse
+import os
+import random
+import struct
+import time
+import zlib
+
+# Generates a synthetic tagged music library for benchmarking (see lib/benchmark.dart).
+#
+# Run:
+#   python3 scripts/synthetic_library_gen.py /tmp/Library --tracks 20000 --albums 2000 --artists 500 --cover-size 600
+#
+# Files are laid out as <album artist>/<album>/<number> - <title>.<extension>. Audio is silent & short (--duration), so the library stays
+# small on disk while the tags are realistic: title, artist (optionally featuring a second artist), album, album artist, genre, year, track
+# & disc numbers. Tracks of the same album embed the same cover (a solid colour PNG of --cover-size pixels), like most real libraries.
+#
+# Formats (--formats, comma separated):
+#   mp3-id3v23  MPEG-1 Layer III with an ID3v2.3 tag.
+#   mp3-id3v24  MPEG-1 Layer III with an ID3v2.4 tag.
+#   flac        FLAC with Vorbis comments & a PICTURE block.
+# Albums are assigned a format in turn. The same --seed always generates the same library.
+
+WORDS = (
+    "after all alone angel autumn away baby back beautiful believe better black blue body broken burning call city cold come "
+    "crazy dance dark day dead desire devil dream drive dust echo electric empty end every eyes fade fall fire forever free "
+    "friend ghost gold gone good heart heaven high home hope hunger ice island kiss last light line little lonely long lost "
+    "love machine midnight mind money moon morning mountain never night ocean only paradise people rain red river road run "
+    "season secret shadow shine silence sky slow smoke song soul star stay still stone storm summer sun sweet tears time "
+    "tonight true wait walk war water wave wild wind winter wonder world young"
+).split()
+
+GENRES = ["Rock", "Pop", "Jazz", "Electronic", "Hip-Hop", "Classical", "Metal", "Folk", "Blues", "R&B", "Country", "Ambient"]
+
+# MPEG-1 Layer III, 128 kbps, 44100 Hz, joint stereo, no CRC. A frame with zeroed side information decodes to silence.
+MP3_FRAME = b"\xff\xfb\x90\x64" + bytes(417 - 4)
+MP3_FRAMES_PER_SECOND = 44100 / 1152
+
+FLAC_BLOCK_SIZE = 4096
+FLAC_SAMPLE_RATE = 44100
+
+
+class Statistics:
+    def __init__(self):
+        self.files = 0
+        self.bytes = 0
+        self.start = time.monotonic()
+
+    def add(self, size):
+        self.files += 1
+        self.bytes += size
+
+    def report(self, total):
+        elapsed = time.monotonic() - self.start
+        print(f"{self.files}/{total} files | {self.bytes / 1024 / 1024:.1f} MiB | {elapsed:.1f}s", flush=True)
+
+
+def name(random, count):
+    return " ".join(random.choice(WORDS).capitalize() for _ in range(count))
+
+
+def sanitize(value):
+    return "".join("_" if c in '/\\:*?"<>|' else c for c in value)
+
+
+def png(size, colour):
+    def chunk(kind, data):
+        return struct.pack(">I", len(data)) + kind + data + struct.pack(">I", zlib.crc32(kind + data) & 0xFFFFFFFF)
+
+    row = b"\x00" + bytes(colour) * size
+    return (
+        b"\x89PNG\r\n\x1a\n"
+        + chunk(b"IHDR", struct.pack(">IIBBBBB", size, size, 8, 2, 0, 0, 0))
+        + chunk(b"IDAT", zlib.compress(row * size, 9))
+        + chunk(b"IEND", b"")
+    )
+
+
+# ID3v2
+
+
+def syncsafe(value):
+    return bytes([(value >> 21) & 0x7F, (value >> 14) & 0x7F, (value >> 7) & 0x7F, value & 0x7F])
+
+
+def id3v2(tags, cover, version):
+    def frame(identifier, data):
+        size = syncsafe(len(data)) if version == 4 else struct.pack(">I", len(data))
+        return identifier.encode("ascii") + size + b"\x00\x00" + data
+
+    def text(value):
+        # UTF-8 (v2.4) or UTF-16 with BOM (v2.3).
+        return b"\x03" + value.encode("utf-8") if version == 4 else b"\x01" + value.encode("utf-16")
+
+    frames = b"".join(
+        frame(identifier, text(tags[key]))
+        for identifier, key in [
+            ("TIT2", "title"),
+            ("TPE1", "artist"),
+            ("TALB", "album"),
+            ("TPE2", "albumartist"),
+            ("TCON", "genre"),
+            ("TYER" if version == 3 else "TDRC", "date"),
+            ("TRCK", "tracknumber"),
+            ("TPOS", "discnumber"),
+        ]
+    )
+    if cover:
+        frames += frame("APIC", b"\x00image/png\x00\x03\x00" + cover)
+    return b"ID3" + bytes([version, 0, 0]) + syncsafe(len(frames)) + frames
+
+
+def mp3(tags, cover, duration, version):
+    return id3v2(tags, cover, version) + MP3_FRAME * max(1, round(duration * MP3_FRAMES_PER_SECOND))
+
+
+# FLAC
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def crc16(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x8005) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def utf8_number(value):
+    if value < 0x80:
+        return bytes([value])
+    if value < 0x800:
+        return bytes([0xC0 | (value >> 6), 0x80 | (value & 0x3F)])
+    return bytes([0xE0 | (value >> 12), 0x80 | ((value >> 6) & 0x3F), 0x80 | (value & 0x3F)])
+
+
+def flac_frame(number):
+    # Fixed block size of 4096 samples, 44.1 kHz, 2 independent channels of 16 bits; each channel a CONSTANT subframe of 0.
+    header = b"\xff\xf8" + bytes([0b1100_1001, 0b0001_1000]) + utf8_number(number)
+    header += bytes([crc8(header)])
+    frame = header + b"\x00\x00\x00" * 2
+    return frame + struct.pack(">H", crc16(frame))
+
+
+def flac(tags, cover, duration):
+    frames = max(1, round(duration * FLAC_SAMPLE_RATE / FLAC_BLOCK_SIZE))
+    samples = frames * FLAC_BLOCK_SIZE
+
+    def block(kind, data, last=False):
+        return bytes([(0x80 if last else 0) | kind]) + struct.pack(">I", len(data))[1:] + data
+
+    stream_info = struct.pack(">HH", FLAC_BLOCK_SIZE, FLAC_BLOCK_SIZE) + b"\x00\x00\x00" * 2
+    # 20 bits sample rate, 3 bits channels - 1, 5 bits bits per sample - 1, 36 bits total samples.
+    stream_info += ((FLAC_SAMPLE_RATE << 44) | (1 << 41) | (15 << 36) | samples).to_bytes(8, "big") + bytes(16)
+
+    vendor = b"Harmonoid"
+    comments = [f"{key.upper()}={value}".encode("utf-8") for key, value in tags.items()]
+    vorbis_comment = struct.pack("<I", len(vendor)) + vendor + struct.pack("<I", len(comments))
+    vorbis_comment += b"".join(struct.pack("<I", len(e)) + e for e in comments)
+
+    blocks = [(0, stream_info), (4, vorbis_comment)]
+    if cover:
+        mime = b"image/png"
+        blocks.append((6, struct.pack(">II", 3, len(mime)) + mime + struct.pack(">IIIIII", 0, 0, 0, 0, 0, len(cover)) + cover))
+    metadata = b"".join(block(kind, data, i == len(blocks) - 1) for i, (kind, data) in enumerate(blocks))
+    return b"fLaC" + metadata + b"".join(flac_frame(i) for i in range(frames))
+
+
+FORMATS = {
+    "mp3-id3v23": ("mp3", lambda tags, cover, duration: mp3(tags, cover, duration, 3)),
+    "mp3-id3v24": ("mp3", lambda tags, cover, duration: mp3(tags, cover, duration, 4)),
+    "flac": ("flac", flac),
+}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate a synthetic tagged music library.")
+    parser.add_argument("output", help="directory to write the library to")
+    parser.add_argument("--tracks", type=int, default=10000)
+    parser.add_argument("--albums", type=int, default=1000)
+    parser.add_argument("--artists", type=int, default=300)
+    parser.add_argument("--formats", default="mp3-id3v23,flac", help=f"comma separated; any of: {', '.join(FORMATS)}")
+    parser.add_argument("--cover-size", type=int, default=500, help="width & height of the covers (px); 0 for none")
+    parser.add_argument("--duration", type=float, default=5.0, help="duration of each track (s)")
+    parser.add_argument("--feat-rate", type=float, default=0.1, help="fraction of tracks featuring a second artist")
+    parser.add_argument("--seed", type=int, default=0)
+    arguments = parser.parse_args()
+
+    formats = [e.strip() for e in arguments.formats.split(",") if e.strip()]
+    for e in formats:
+        if e not in FORMATS:
+            parser.error(f"unknown format: {e}")
+    albums_count = max(1, min(arguments.albums, arguments.tracks))
+    artists_count = max(1, min(arguments.artists, albums_count))
+
+    rng = random.Random(arguments.seed)
+    artists = []
+    while len(artists) < artists_count:
+        artist = name(rng, rng.randint(1, 3))
+        if artist not in artists:
+            artists.append(artist)
+    # Every artist has at least one album.
+    albums = [
+        {
+            "album": name(rng, rng.randint(1, 4)),
+            "albumartist": artists[i] if i < artists_count else rng.choice(artists),
+            "genre": rng.choice(GENRES),
+            "date": str(rng.randint(1960, 2025)),
+            "format": formats[i % len(formats)],
+            "colour": (rng.randrange(256), rng.randrange(256), rng.randrange(256)),
+            "tracks": 0,
+        }
+        for i in range(albums_count)
+    ]
+    # Every album has at least one track; the rest are distributed at random.
+    assignments = list(range(albums_count)) + [rng.randrange(albums_count) for _ in range(arguments.tracks - albums_count)]
+
+    statistics = Statistics()
+    covers = {}
+    for album_index in assignments:
+        album = albums[album_index]
+        album["tracks"] += 1
+        number = album["tracks"]
+        artist = album["albumartist"]
+        if rng.random() < arguments.feat_rate:
+            artist = f"{artist} feat. {rng.choice(artists)}"
+        title = name(rng, rng.randint(1, 5))
+        tags = {
+            "title": title,
+            "artist": artist,
+            "album": album["album"],
+            "albumartist": album["albumartist"],
+            "genre": album["genre"],
+            "date": album["date"],
+            "tracknumber": str(number),
+            "discnumber": "1",
+        }
+        if arguments.cover_size > 0 and album_index not in covers:
+            covers[album_index] = png(arguments.cover_size, album["colour"])
+        extension, encode = FORMATS[album["format"]]
+        directory = os.path.join(arguments.output, sanitize(album["albumartist"]), f"{sanitize(album['album'])} ({album_index})")
+        os.makedirs(directory, exist_ok=True)
+        data = encode(tags, covers.get(album_index), arguments.duration)
+        with open(os.path.join(directory, f"{number:03d} - {sanitize(title)}.{extension}"), "wb") as file:
+            file.write(data)
+        statistics.add(len(data))
+        if statistics.files % 1000 == 0:
+            statistics.report(arguments.tracks)
+    statistics.report(arguments.tracks)
+
+
+if __name__ == "__main__":
+    main()